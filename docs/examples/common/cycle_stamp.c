@@ -0,0 +1,35 @@
+/*
+ * 64-bit Cycle Stamps
+ *
+ * The software count keeps the last 32-bit reading and the wraps seen
+ * so far under a spinlock, so callers in threads and ISRs share one
+ * consistent count.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "cycle_stamp.h"
+
+static struct k_spinlock lock;
+static uint32_t last;
+static uint64_t high;
+
+uint64_t cycle_stamp_get(void)
+{
+	if (IS_ENABLED(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)) {
+		return k_cycle_get_64();
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t now = k_cycle_get_32();
+
+	if (now < last) {
+		high += BIT64(32);
+	}
+	last = now;
+
+	uint64_t cycles = high | now;
+
+	k_spin_unlock(&lock, key);
+	return cycles;
+}
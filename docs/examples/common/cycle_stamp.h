@@ -0,0 +1,21 @@
+/*
+ * 64-bit Cycle Stamps
+ *
+ * k_cycle_get_64() only works with CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER;
+ * SysTick-based Cortex-M boards (qemu_cortex_m3, stm32f769i_disco) do
+ * not have it. cycle_stamp_get() uses the 64-bit counter where there is
+ * one and otherwise extends k_cycle_get_32() in software by counting its
+ * wraps. That is exact as long as calls, from any caller, are less than
+ * one wrap apart: about 6 minutes at qemu_cortex_m3's 12 MHz, 20 s at
+ * 216 MHz.
+ */
+
+#ifndef CYCLE_STAMP_H_
+#define CYCLE_STAMP_H_
+
+#include <zephyr/kernel.h>
+
+/* Hardware cycles since boot, modulo the wrap rule above */
+uint64_t cycle_stamp_get(void);
+
+#endif /* CYCLE_STAMP_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Latency Histogram
+ *
+ * The log2 histogram the benchmarks and tracers report percentiles
+ * from. Bucket b counts values of 2^(b-1) to 2^b - 1 (the last one is
+ * open), so adding a sample is a find_msb_set() and an increment, and
+ * a percentile comes back as the upper bound of the bucket it falls
+ * in. The unit is whatever the caller adds: cycles in the benchmarks,
+ * microseconds in the work tracer. There is no locking; callers that
+ * add from several threads serialize the adds themselves or keep one
+ * histogram per thread and merge them afterwards.
+ */
+
+#ifndef LAT_HIST_H_
+#define LAT_HIST_H_
+
+#include <zephyr/kernel.h>
+
+#define LAT_HIST_BUCKETS 32
+
+struct lat_hist {
+	uint32_t buckets[LAT_HIST_BUCKETS];
+	uint32_t count;
+	uint32_t max;
+};
+
+static inline void lat_hist_add(struct lat_hist *hist, uint32_t value)
+{
+	hist->buckets[MIN(find_msb_set(value), LAT_HIST_BUCKETS - 1)]++;
+	hist->count++;
+	hist->max = MAX(hist->max, value);
+}
+
+/* Add everything in @p from to @p into */
+static inline void lat_hist_merge(struct lat_hist *into,
+				  const struct lat_hist *from)
+{
+	for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+		into->buckets[b] += from->buckets[b];
+	}
+	into->count += from->count;
+	into->max = MAX(into->max, from->max);
+}
+
+/* Upper bound of the bucket holding the @p pct_x10 / 10 percentile */
+static inline uint32_t lat_hist_percentile(const struct lat_hist *hist,
+					   uint32_t pct_x10)
+{
+	uint64_t target = ((uint64_t)hist->count * pct_x10 + 999) / 1000;
+	uint64_t seen = 0;
+
+	if (hist->count == 0) {
+		return 0;
+	}
+
+	for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+		seen += hist->buckets[b];
+		if (seen >= target) {
+			return b == 0 ? 0 : BIT(b) - 1;
+		}
+	}
+
+	return UINT32_MAX;
+}
+
+#endif /* LAT_HIST_H_ */
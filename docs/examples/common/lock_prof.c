@@ -0,0 +1,271 @@
+/*
+ * Mutex Contention Profiler
+ *
+ * A lock attempt that fails with K_NO_WAIT counts as contended and the
+ * blocking lock that follows is timed as wait. The counters sit behind
+ * a spinlock private to the profile, held only to update or copy them,
+ * so reading them never contends for the profiled mutex. Since k_mutex
+ * is recursive, the profile counts nesting itself and hold time runs
+ * from the outermost lock to the matching unlock.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lock_prof.h"
+
+static sys_slist_t profiles = SYS_SLIST_STATIC_INIT(&profiles);
+static struct k_spinlock profiles_lock;
+
+static void register_once(struct lock_prof *prof)
+{
+	if (atomic_get(&prof->registered) != 0) {
+		return;
+	}
+	if (!atomic_cas(&prof->registered, 0, 1)) {
+		return;	/* another thread won the race */
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&profiles_lock);
+
+	sys_slist_append(&profiles, &prof->node);
+	k_spin_unlock(&profiles_lock, key);
+}
+
+int lock_prof_lock(struct lock_prof *prof, k_timeout_t timeout)
+{
+	bool contended = false;
+	uint32_t wait = 0;
+	int ret;
+
+	register_once(prof);
+
+	ret = k_mutex_lock(prof->mutex, K_NO_WAIT);
+	if (ret != 0 && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		uint32_t start = k_cycle_get_32();
+
+		contended = true;
+		ret = k_mutex_lock(prof->mutex, timeout);
+		wait = k_cycle_get_32() - start;
+	}
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	/* Nested locks by the owner are not new acquisitions */
+	if (prof->depth++ > 0) {
+		return 0;
+	}
+
+	prof->owner = k_current_get();
+
+	k_spinlock_key_t key = k_spin_lock(&prof->lock);
+
+	prof->acquisitions++;
+	if (contended) {
+		prof->contended++;
+		prof->wait_total += wait;
+		prof->wait_max = MAX(prof->wait_max, wait);
+	}
+	k_spin_unlock(&prof->lock, key);
+
+	prof->hold_start = k_cycle_get_32();
+
+	return 0;
+}
+
+int lock_prof_unlock(struct lock_prof *prof)
+{
+	/* Not the holder: let k_mutex_unlock() report the error */
+	if (prof->depth == 0 || prof->owner != k_current_get()) {
+		return k_mutex_unlock(prof->mutex);
+	}
+
+	if (--prof->depth == 0) {
+		uint32_t held = k_cycle_get_32() - prof->hold_start;
+		k_spinlock_key_t key = k_spin_lock(&prof->lock);
+
+		prof->hold_max = MAX(prof->hold_max, held);
+		k_spin_unlock(&prof->lock, key);
+		prof->owner = NULL;
+	}
+
+	return k_mutex_unlock(prof->mutex);
+}
+
+void lock_prof_snapshot(struct lock_prof *prof,
+			struct lock_prof_snapshot *snap)
+{
+	k_spinlock_key_t key = k_spin_lock(&prof->lock);
+	uint32_t wait_max = prof->wait_max;
+	uint32_t hold_max = prof->hold_max;
+	uint64_t wait_total = prof->wait_total;
+
+	snap->acquisitions = prof->acquisitions;
+	snap->contended = prof->contended;
+	k_spin_unlock(&prof->lock, key);
+
+	/* Unit conversion outside the lock */
+	snap->wait_total_us = k_cyc_to_us_floor64(wait_total);
+	snap->wait_max_us = k_cyc_to_us_floor32(wait_max);
+	snap->hold_max_us = k_cyc_to_us_floor32(hold_max);
+}
+
+static void reset_one(struct lock_prof *prof)
+{
+	k_spinlock_key_t key = k_spin_lock(&prof->lock);
+
+	prof->acquisitions = 0;
+	prof->contended = 0;
+	prof->wait_total = 0;
+	prof->wait_max = 0;
+	prof->hold_max = 0;
+	k_spin_unlock(&prof->lock, key);
+}
+
+/*
+ * Profiles are only ever appended, so the list can be walked without
+ * profiles_lock.
+ */
+void lock_prof_reset(void)
+{
+	struct lock_prof *prof;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&profiles, prof, node) {
+		reset_one(prof);
+	}
+}
+
+/* Contended share of acquisitions, in tenths of a percent */
+static uint32_t contended_x10(const struct lock_prof_snapshot *snap)
+{
+	return snap->acquisitions ?
+		(uint32_t)((uint64_t)snap->contended * 1000 /
+			   snap->acquisitions) : 0;
+}
+
+void lock_prof_dump(void)
+{
+	struct lock_prof *prof;
+	struct lock_prof_snapshot snap;
+
+	printk("%-16s %8s %7s %12s %10s %10s\n", "mutex", "acq", "cont%",
+	       "wait us", "wait max", "hold max");
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&profiles, prof, node) {
+		lock_prof_snapshot(prof, &snap);
+
+		uint32_t pct = contended_x10(&snap);
+
+		printk("%-16s %8u %5u.%u %12llu %10u %10u\n", prof->name,
+		       snap.acquisitions, pct / 10, pct % 10,
+		       (unsigned long long)snap.wait_total_us,
+		       snap.wait_max_us, snap.hold_max_us);
+	}
+}
+
+/* ---- Periodic dump ---- */
+
+static k_timeout_t dump_period;
+
+static void dump_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(dump_work, dump_work_handler);
+
+static void dump_work_handler(struct k_work *work)
+{
+	printk("--- lock profile @ %u ms ---\n", k_uptime_get_32());
+	lock_prof_dump();
+
+	k_work_schedule(k_work_delayable_from_work(work), dump_period);
+}
+
+void lock_prof_dump_start(k_timeout_t period)
+{
+	dump_period = period;
+	k_work_reschedule(&dump_work, period);
+}
+
+void lock_prof_dump_stop(void)
+{
+	k_work_cancel_delayable(&dump_work);
+}
+
+/* ---- Shell commands ---- */
+
+#ifdef CONFIG_SHELL
+
+static int cmd_lockprof_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct lock_prof *prof;
+	struct lock_prof_snapshot snap;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&profiles, prof, node) {
+		if (argc > 1 && strcmp(prof->name, argv[1]) != 0) {
+			continue;
+		}
+
+		lock_prof_snapshot(prof, &snap);
+
+		uint32_t pct = contended_x10(&snap);
+
+		shell_print(sh, "%s:", prof->name);
+		shell_print(sh, "  acquisitions %u, contended %u (%u.%u%%)",
+			    snap.acquisitions, snap.contended, pct / 10,
+			    pct % 10);
+		shell_print(sh, "  wait total %llu us, max %u us",
+			    (unsigned long long)snap.wait_total_us,
+			    snap.wait_max_us);
+		shell_print(sh, "  hold max %u us", snap.hold_max_us);
+	}
+
+	return 0;
+}
+
+static int cmd_lockprof_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	lock_prof_reset();
+	shell_print(sh, "Lock counters reset");
+
+	return 0;
+}
+
+static int cmd_lockprof_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	int ms = atoi(argv[1]);
+
+	if (ms == 0) {
+		lock_prof_dump_stop();
+		shell_print(sh, "Periodic lock dump stopped");
+		return 0;
+	}
+
+	if (ms < 100) {
+		shell_error(sh, "Period must be 0 (off) or >= 100 ms");
+		return -EINVAL;
+	}
+
+	lock_prof_dump_start(K_MSEC(ms));
+	shell_print(sh, "Dumping lock profile every %d ms", ms);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(lockprof_cmds,
+	SHELL_CMD_ARG(show, NULL, "Show mutex statistics [name]",
+		      cmd_lockprof_show, 1, 1),
+	SHELL_CMD(reset, NULL, "Reset all counters", cmd_lockprof_reset),
+	SHELL_CMD_ARG(dump, NULL, "Set periodic dump interval <ms|0>",
+		      cmd_lockprof_dump, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(lockprof, &lockprof_cmds, "Mutex contention profiler",
+		   NULL);
+
+#endif /* CONFIG_SHELL */
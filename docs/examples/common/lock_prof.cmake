@@ -0,0 +1,8 @@
+# Opt-in mutex contention profiler shared by several examples.
+# Enable with: west build ... -- -DLOCK_PROF=ON
+option(LOCK_PROF "Profile mutex contention with lock_prof" OFF)
+target_include_directories(app PRIVATE ${CMAKE_CURRENT_LIST_DIR})
+if(LOCK_PROF)
+  target_compile_definitions(app PRIVATE LOCK_PROF_ENABLED)
+  target_sources(app PRIVATE ${CMAKE_CURRENT_LIST_DIR}/lock_prof.c)
+endif()
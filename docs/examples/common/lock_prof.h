@@ -0,0 +1,108 @@
+/*
+ * Mutex Contention Profiler
+ *
+ * Opt-in statistics for individual k_mutex objects: acquisitions, how
+ * many of them had to wait, total and longest wait, and longest hold.
+ * A mutex opts in by getting a profile next to its definition and by
+ * being locked through lock_prof_lock()/lock_prof_unlock():
+ *
+ *   K_MUTEX_DEFINE(counter_mutex);
+ *   LOCK_PROF_DEFINE(counter_mutex);
+ *
+ *   lock_prof_lock(&counter_mutex_prof, K_FOREVER);
+ *   ...
+ *   lock_prof_unlock(&counter_mutex_prof);
+ *
+ * Profiles register themselves on first use. Results are available
+ * with lock_prof_dump(), as a periodic dump, and with the "lockprof"
+ * shell command when CONFIG_SHELL is enabled.
+ *
+ * Profiling is compiled in only when LOCK_PROF_ENABLED is defined, which
+ * lock_prof.cmake does for -DLOCK_PROF=ON. Otherwise the calls are
+ * plain k_mutex calls.
+ */
+
+#ifndef LOCK_PROF_H_
+#define LOCK_PROF_H_
+
+#include <zephyr/kernel.h>
+
+struct lock_prof {
+	struct k_mutex *mutex;
+	const char *name;
+#ifdef LOCK_PROF_ENABLED
+	sys_snode_t node;
+	atomic_t registered;
+
+	/* Owned by the thread holding the mutex */
+	k_tid_t owner;
+	uint32_t depth;		/* nested lock_prof_lock() calls */
+	uint32_t hold_start;
+
+	/* Counters, under the profile's own lock */
+	struct k_spinlock lock;
+	uint32_t acquisitions;
+	uint32_t contended;
+	uint64_t wait_total;	/* cycles */
+	uint32_t wait_max;	/* cycles */
+	uint32_t hold_max;	/* cycles */
+#endif
+};
+
+/* Define the profile <mutex>_prof for the mutex named @p _mutex */
+#define LOCK_PROF_DEFINE(_mutex)                                           \
+	static struct lock_prof _mutex##_prof = {                          \
+		.mutex = &_mutex,                                          \
+		.name = #_mutex,                                           \
+	}
+
+struct lock_prof_snapshot {
+	uint32_t acquisitions;
+	uint32_t contended;
+	uint64_t wait_total_us;
+	uint32_t wait_max_us;
+	uint32_t hold_max_us;
+};
+
+#ifdef LOCK_PROF_ENABLED
+
+/* k_mutex_lock() that records wait and hold times */
+int lock_prof_lock(struct lock_prof *prof, k_timeout_t timeout);
+
+/* k_mutex_unlock() that records the hold time */
+int lock_prof_unlock(struct lock_prof *prof);
+
+/* Copy the counters of @p prof without touching the profiled mutex */
+void lock_prof_snapshot(struct lock_prof *prof,
+			struct lock_prof_snapshot *snap);
+
+/* Print a table of all registered profiles */
+void lock_prof_dump(void);
+
+/* Zero the counters of all registered profiles */
+void lock_prof_reset(void);
+
+/* Call lock_prof_dump() every @p period from the system workqueue */
+void lock_prof_dump_start(k_timeout_t period);
+void lock_prof_dump_stop(void);
+
+#else
+
+static inline int lock_prof_lock(struct lock_prof *prof, k_timeout_t timeout)
+{
+	return k_mutex_lock(prof->mutex, timeout);
+}
+
+static inline int lock_prof_unlock(struct lock_prof *prof)
+{
+	return k_mutex_unlock(prof->mutex);
+}
+
+static inline void lock_prof_dump(void) {}
+static inline void lock_prof_reset(void) {}
+static inline void lock_prof_dump_start(k_timeout_t period) {}
+static inline void lock_prof_dump_stop(void) {}
+
+#endif /* LOCK_PROF_ENABLED */
+
+#endif /* LOCK_PROF_H_ */
@@ -0,0 +1,201 @@
+/*
+ * Batching Periodic Task Scheduler
+ *
+ * Choosing the earliest deadline (due + slack) as the wakeup and then
+ * running everything due by that time is the classic greedy answer to
+ * covering a set of windows with the fewest points: no schedule that
+ * keeps every task inside its window wakes up less often.
+ *
+ * The scheduler thread sleeps in k_sem_take() with the planned wakeup as
+ * an absolute timeout, so timing out means "run what is due". Adding a
+ * task or stopping gives the semaphore instead, which makes the thread
+ * plan again without running anything. A give that lands while the
+ * thread is still planning stays pending in the semaphore, so it is
+ * never lost.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "periodic_sched.h"
+
+#define SCHED_STACK_SIZE 1024
+#define SCHED_PRIORITY 5
+
+static sys_slist_t tasks = SYS_SLIST_STATIC_INIT(&tasks);
+static K_MUTEX_DEFINE(tasks_lock);
+static K_SEM_DEFINE(replan_sem, 0, 1);
+
+K_THREAD_STACK_DEFINE(sched_stack, SCHED_STACK_SIZE);
+static struct k_thread sched_thread;
+static atomic_t sched_running;
+
+/* Wakeup accounting since periodic_sched_start() */
+static int64_t start_ticks;
+static uint32_t wakeups;
+static uint32_t unbatched_wakeups;
+
+void periodic_sched_add(struct periodic_task *task)
+{
+	k_mutex_lock(&tasks_lock, K_FOREVER);
+
+	task->period = MAX(k_ms_to_ticks_ceil32(task->period_ms), 1);
+	task->slack = k_ms_to_ticks_ceil32(task->slack_ms);
+	task->due = k_uptime_ticks() + task->period;
+	task->last_due = -1;
+	task->runs = 0;
+	task->late_max_ms = 0;
+	sys_slist_append(&tasks, &task->node);
+
+	k_mutex_unlock(&tasks_lock);
+
+	/* Replan; the new task may be the most urgent one */
+	k_sem_give(&replan_sem);
+}
+
+/* Latest tick at which every task is still within its window */
+static int64_t plan_wakeup(void)
+{
+	struct periodic_task *task;
+	int64_t wake = INT64_MAX;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tasks, task, node) {
+		wake = MIN(wake, task->due + task->slack);
+	}
+
+	return wake;
+}
+
+/*
+ * On their own, tasks due in the same tick would still share a wakeup.
+ * Every earlier batch only ran dues before this one's, so a matching
+ * last_due means the task ran in this batch.
+ */
+static bool due_tick_seen(struct periodic_task *upto, int64_t due)
+{
+	struct periodic_task *task;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tasks, task, node) {
+		if (task == upto) {
+			return false;
+		}
+		if (task->last_due == due) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void run_due(int64_t now)
+{
+	struct periodic_task *task;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tasks, task, node) {
+		if (task->due > now) {
+			continue;
+		}
+
+		int64_t due = task->due;
+		uint32_t late_ms = k_ticks_to_ms_floor32((uint32_t)(now - due));
+
+		task->late_max_ms = MAX(task->late_max_ms, late_ms);
+		task->fn(task);
+		task->runs++;
+		task->last_due = due;
+
+		/* Whole periods keep the phase; skip any that were missed */
+		do {
+			task->due += task->period;
+		} while (task->due <= now);
+
+		if (!due_tick_seen(task, due)) {
+			unbatched_wakeups++;
+		}
+	}
+}
+
+static void sched_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&sched_running)) {
+		k_mutex_lock(&tasks_lock, K_FOREVER);
+		int64_t wake = plan_wakeup();
+		k_mutex_unlock(&tasks_lock);
+
+		/* No tasks yet: wait for periodic_sched_add() */
+		k_timeout_t timeout = wake == INT64_MAX ? K_FOREVER :
+			K_TIMEOUT_ABS_TICKS(wake);
+
+		if (k_sem_take(&replan_sem, timeout) == 0) {
+			continue;	/* task added or stopping: replan or exit */
+		}
+
+		k_mutex_lock(&tasks_lock, K_FOREVER);
+		wakeups++;
+		run_due(k_uptime_ticks());
+		k_mutex_unlock(&tasks_lock);
+	}
+}
+
+void periodic_sched_start(void)
+{
+	if (!atomic_cas(&sched_running, 0, 1)) {
+		return;
+	}
+
+	start_ticks = k_uptime_ticks();
+	wakeups = 0;
+	unbatched_wakeups = 0;
+
+	k_tid_t tid = k_thread_create(&sched_thread, sched_stack,
+				      K_THREAD_STACK_SIZEOF(sched_stack),
+				      sched_entry, NULL, NULL, NULL,
+				      SCHED_PRIORITY, 0, K_NO_WAIT);
+
+	k_thread_name_set(tid, "periodic_sched");
+}
+
+void periodic_sched_stop(void)
+{
+	if (!atomic_cas(&sched_running, 1, 0)) {
+		return;
+	}
+
+	k_sem_give(&replan_sem);
+	k_thread_join(&sched_thread, K_FOREVER);
+}
+
+/* @p count per second over @p ticks, in tenths */
+static uint32_t per_sec_x10(uint32_t count, int64_t ticks)
+{
+	return ticks > 0 ? (uint32_t)((uint64_t)count * 10 *
+				      CONFIG_SYS_CLOCK_TICKS_PER_SEC / ticks) : 0;
+}
+
+void periodic_sched_dump(void)
+{
+	struct periodic_task *task;
+
+	k_mutex_lock(&tasks_lock, K_FOREVER);
+
+	int64_t elapsed = k_uptime_ticks() - start_ticks;
+	uint32_t taken = per_sec_x10(wakeups, elapsed);
+	uint32_t alone = per_sec_x10(unbatched_wakeups, elapsed);
+	uint32_t saved = alone > taken ? alone - taken : 0;
+
+	printk("%-16s %8s %8s %6s %9s\n", "task", "period", "slack",
+	       "runs", "late max");
+	SYS_SLIST_FOR_EACH_CONTAINER(&tasks, task, node) {
+		printk("%-16s %5u ms %5u ms %6u %6u ms\n", task->name,
+		       task->period_ms, task->slack_ms, task->runs,
+		       task->late_max_ms);
+	}
+	printk("Wakeups/s: %u.%u batched, %u.%u unbatched, %u.%u saved\n",
+	       taken / 10, taken % 10, alone / 10, alone % 10, saved / 10,
+	       saved % 10);
+
+	k_mutex_unlock(&tasks_lock);
+}
@@ -0,0 +1,71 @@
+/*
+ * Batching Periodic Task Scheduler
+ *
+ * Runs periodic tasks from one thread, and lines up
+ * tasks whose timing allows it onto shared wakeups. Each task has a
+ * period and a slack: it may run anywhere from its due time to slack
+ * later. The scheduler sleeps until the latest moment at which the most
+ * urgent task can still run, then runs every task that is due by then,
+ * so tasks with compatible periods end up sharing wakeups instead of
+ * waking the system one by one. Due times advance by whole periods, so
+ * running late within the slack does not make a task drift.
+ *
+ *   static void poll_battery(struct periodic_task *task);
+ *   PERIODIC_TASK_DEFINE(battery_task, poll_battery, 2000, 500);
+ *
+ *   periodic_sched_add(&battery_task);
+ *   periodic_sched_start();
+ *
+ * Times are kept in kernel ticks, so periods and slack are rounded to
+ * CONFIG_SYS_CLOCK_TICKS_PER_SEC. periodic_sched_dump() reports the
+ * wakeups per second taken and the wakeups per second the same tasks
+ * would have caused on their own (one per distinct due tick).
+ */
+
+#ifndef PERIODIC_SCHED_H_
+#define PERIODIC_SCHED_H_
+
+#include <zephyr/kernel.h>
+
+struct periodic_task;
+
+typedef void (*periodic_task_fn)(struct periodic_task *task);
+
+struct periodic_task {
+	sys_snode_t node;
+	const char *name;
+	periodic_task_fn fn;
+	uint32_t period_ms;
+	uint32_t slack_ms;
+
+	/* Scheduler state, in ticks */
+	int64_t due;
+	int64_t last_due;	/* due time of the latest run */
+	uint32_t period;
+	uint32_t slack;
+
+	uint32_t runs;
+	uint32_t late_max_ms;	/* worst start after the due time */
+};
+
+#define PERIODIC_TASK_DEFINE(_name, _fn, _period_ms, _slack_ms)            \
+	struct periodic_task _name = {                                     \
+		.name = #_name,                                            \
+		.fn = _fn,                                                 \
+		.period_ms = _period_ms,                                   \
+		.slack_ms = _slack_ms,                                     \
+	}
+
+/* Add @p task, first due one period from now; may be called while running */
+void periodic_sched_add(struct periodic_task *task);
+
+/* Start the scheduler thread and reset the wakeup counters */
+void periodic_sched_start(void);
+
+/* Stop the scheduler thread; tasks stay registered */
+void periodic_sched_stop(void);
+
+/* Print per-task runs and the wakeups per second taken and saved */
+void periodic_sched_dump(void);
+
+#endif /* PERIODIC_SCHED_H_ */
@@ -0,0 +1,270 @@
+/*
+ * Priority-Class Workqueue
+ *
+ * Each class keeps its pending items in a list sorted by deadline and
+ * has one "drain" item on its kernel work queue. Submitting inserts the
+ * item and submits the drain item, which then runs items from the head
+ * of the list until it is empty. Since the kernel work queue only ever
+ * holds the drain item, the order in which items run is decided here
+ * and not by the queue's FIFO.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "prio_wq.h"
+
+#define NO_DEADLINE INT64_MAX
+
+struct prio_class {
+	struct k_work_q queue;
+	struct k_work drain;
+	sys_slist_t pending;	/* sorted by deadline */
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(prio_wq_stacks, PRIO_WQ_CLASSES,
+			    PRIO_WQ_STACK_SIZE);
+static struct prio_class classes[PRIO_WQ_CLASSES];
+static struct k_spinlock lock;
+
+static sys_slist_t types = SYS_SLIST_STATIC_INIT(&types);
+static struct k_spinlock types_lock;
+
+static const char *const class_names[] = { "high", "normal", "low" };
+
+BUILD_ASSERT(ARRAY_SIZE(class_names) == PRIO_WQ_CLASSES);
+
+static void register_once(struct prio_work_type *type)
+{
+	if (atomic_get(&type->registered) != 0 ||
+	    !atomic_cas(&type->registered, 0, 1)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&types_lock);
+
+	sys_slist_append(&types, &type->node);
+	k_spin_unlock(&types_lock, key);
+}
+
+static void record(struct prio_work_type *type, int64_t deadline)
+{
+	atomic_inc(&type->runs);
+
+	if (deadline == NO_DEADLINE) {
+		return;
+	}
+
+	int64_t late = k_uptime_ticks() - deadline;
+
+	if (late <= 0) {
+		return;
+	}
+
+	atomic_val_t late_us = (atomic_val_t)k_ticks_to_us_floor64(late);
+	atomic_val_t max;
+
+	atomic_inc(&type->missed);
+	do {
+		max = atomic_get(&type->late_max_us);
+	} while (late_us > max &&
+		 !atomic_cas(&type->late_max_us, max, late_us));
+}
+
+static void drain_handler(struct k_work *drain)
+{
+	struct prio_class *cls = CONTAINER_OF(drain, struct prio_class, drain);
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		sys_snode_t *node = sys_slist_get(&cls->pending);
+
+		if (node == NULL) {
+			k_spin_unlock(&lock, key);
+			break;
+		}
+
+		struct prio_work *pw = CONTAINER_OF(node, struct prio_work, node);
+		/* The handler may resubmit and change the deadline */
+		int64_t deadline = pw->deadline;
+
+		pw->queued = false;
+		k_spin_unlock(&lock, key);
+
+		pw->work.handler(&pw->work);
+		record(pw->type, deadline);
+	}
+}
+
+void prio_work_init(struct prio_work *pw, k_work_handler_t handler,
+		    struct prio_work_type *type, enum prio_wq_class cls)
+{
+	__ASSERT(cls < PRIO_WQ_CLASSES, "bad class %d", cls);
+
+	*pw = (struct prio_work){
+		.type = type,
+		.cls = cls,
+		.deadline = NO_DEADLINE,
+	};
+	k_work_init(&pw->work, handler);
+}
+
+void prio_wq_start(int prio)
+{
+	for (size_t i = 0; i < PRIO_WQ_CLASSES; i++) {
+		struct prio_class *cls = &classes[i];
+		char name[16];
+		struct k_work_queue_config cfg = {
+			.name = name,
+		};
+
+		snprintk(name, sizeof(name), "prio_wq_%s", class_names[i]);
+
+		sys_slist_init(&cls->pending);
+		k_work_init(&cls->drain, drain_handler);
+		k_work_queue_init(&cls->queue);
+		k_work_queue_start(&cls->queue, prio_wq_stacks[i],
+				   K_THREAD_STACK_SIZEOF(prio_wq_stacks[i]),
+				   prio + (int)i, &cfg);
+	}
+}
+
+/* Insert behind every item due no later, so equal deadlines stay FIFO */
+static void insert_sorted(sys_slist_t *list, struct prio_work *pw)
+{
+	sys_snode_t *prev = NULL;
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		struct prio_work *other =
+			CONTAINER_OF(node, struct prio_work, node);
+
+		if (other->deadline > pw->deadline) {
+			break;
+		}
+		prev = node;
+	}
+
+	sys_slist_insert(list, prev, &pw->node);
+}
+
+/*
+ * Uptime tick at which @p deadline expires. Going through a timepoint
+ * handles K_TIMEOUT_ABS_* as well as relative timeouts; an absolute
+ * deadline already in the past comes out as now.
+ */
+static int64_t due_ticks(k_timeout_t deadline)
+{
+	if (K_TIMEOUT_EQ(deadline, K_FOREVER)) {
+		return NO_DEADLINE;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(deadline);
+
+	return k_uptime_ticks() + sys_timepoint_timeout(end).ticks;
+}
+
+int prio_work_submit(struct prio_work *pw, k_timeout_t deadline)
+{
+	struct prio_class *cls = &classes[pw->cls];
+	int64_t due = due_ticks(deadline);
+	int ret = 1;
+
+	register_once(pw->type);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (pw->queued) {
+		ret = 0;
+		if (due < pw->deadline) {
+			sys_slist_find_and_remove(&cls->pending, &pw->node);
+			pw->deadline = due;
+			insert_sorted(&cls->pending, pw);
+		}
+	} else {
+		pw->queued = true;
+		pw->deadline = due;
+		insert_sorted(&cls->pending, pw);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret == 1) {
+		k_work_submit_to_queue(&cls->queue, &cls->drain);
+	}
+
+	return ret;
+}
+
+void prio_wq_dump(void)
+{
+	struct prio_work_type *type;
+
+	printk("%-16s %8s %8s %12s\n", "work type", "runs", "missed",
+	       "late max us");
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&types, type, node) {
+		printk("%-16s %8u %8u %12u\n", type->name,
+		       (unsigned int)atomic_get(&type->runs),
+		       (unsigned int)atomic_get(&type->missed),
+		       (unsigned int)atomic_get(&type->late_max_us));
+	}
+}
+
+/* Types are only ever appended, so the list is walked without a lock */
+void prio_wq_reset(void)
+{
+	struct prio_work_type *type;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&types, type, node) {
+		atomic_set(&type->runs, 0);
+		atomic_set(&type->missed, 0);
+		atomic_set(&type->late_max_us, 0);
+	}
+}
+
+/* ---- Shell commands ---- */
+
+#ifdef CONFIG_SHELL
+
+static int cmd_priowq_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct prio_work_type *type;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-16s %8s %8s %12s", "work type", "runs", "missed",
+		    "late max us");
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&types, type, node) {
+		shell_print(sh, "%-16s %8u %8u %12u", type->name,
+			    (unsigned int)atomic_get(&type->runs),
+			    (unsigned int)atomic_get(&type->missed),
+			    (unsigned int)atomic_get(&type->late_max_us));
+	}
+
+	return 0;
+}
+
+static int cmd_priowq_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	prio_wq_reset();
+	shell_print(sh, "Work type counters reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(priowq_cmds,
+	SHELL_CMD(show, NULL, "Show runs and missed deadlines per work type",
+		  cmd_priowq_show),
+	SHELL_CMD(reset, NULL, "Reset all counters", cmd_priowq_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(priowq, &priowq_cmds, "Priority-class workqueue", NULL);
+
+#endif /* CONFIG_SHELL */
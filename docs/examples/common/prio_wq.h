@@ -0,0 +1,95 @@
+/*
+ * Priority-Class Workqueue
+ *
+ * Three work queues, one per class, whose threads run at consecutive
+ * priorities so that high-class work preempts normal and low work.
+ * Within a class, items run earliest deadline first; items without a
+ * deadline run after those with one, in submission order. When an item
+ * finishes after its deadline, the miss is counted against the item's
+ * type, so the effect of a slow handler shows up on the types it
+ * delays:
+ *
+ *   static PRIO_WORK_TYPE_DEFINE(button_type, "button");
+ *   static struct prio_work button_work;
+ *
+ *   prio_work_init(&button_work, button_work_handler, &button_type,
+ *                  PRIO_WQ_HIGH);
+ *   prio_work_submit(&button_work, K_MSEC(20));
+ *
+ * Handlers take a struct k_work like any other work handler; use
+ * prio_work_from_work() or CONTAINER_OF() to get back to the item.
+ * Types register on first submit. Results are available with
+ * prio_wq_dump() and, with CONFIG_SHELL, the "priowq" shell command.
+ */
+
+#ifndef PRIO_WQ_H_
+#define PRIO_WQ_H_
+
+#include <zephyr/kernel.h>
+
+enum prio_wq_class {
+	PRIO_WQ_HIGH,
+	PRIO_WQ_NORMAL,
+	PRIO_WQ_LOW,
+	PRIO_WQ_CLASSES,
+};
+
+/* Stack of each class worker thread */
+#define PRIO_WQ_STACK_SIZE 1024
+
+struct prio_work_type {
+	const char *name;
+	sys_snode_t node;
+	atomic_t registered;
+
+	atomic_t runs;
+	atomic_t missed;
+	atomic_t late_max_us;	/* worst finish past the deadline */
+};
+
+#define PRIO_WORK_TYPE_DEFINE(_name, _label)                              \
+	struct prio_work_type _name = {                                    \
+		.name = _label,                                            \
+	}
+
+struct prio_work {
+	struct k_work work;	/* handler lives here */
+	sys_snode_t node;
+	struct prio_work_type *type;
+	enum prio_wq_class cls;
+	bool queued;
+	int64_t deadline;	/* uptime ticks, INT64_MAX for none */
+};
+
+void prio_work_init(struct prio_work *pw, k_work_handler_t handler,
+		    struct prio_work_type *type, enum prio_wq_class cls);
+
+static inline struct prio_work *prio_work_from_work(struct k_work *work)
+{
+	return CONTAINER_OF(work, struct prio_work, work);
+}
+
+/*
+ * Start the class threads: PRIO_WQ_HIGH runs at @p prio, each lower
+ * class one priority level below the previous one.
+ */
+void prio_wq_start(int prio);
+
+/**
+ * Queue @p pw in its class, to be finished within @p deadline from now,
+ * or by it if it is a K_TIMEOUT_ABS_* timeout (K_FOREVER for no
+ * deadline). May be called from an ISR.
+ *
+ * @retval 1 Item queued.
+ * @retval 0 Item was already queued; its deadline is moved earlier if
+ *           the new one is earlier.
+ */
+int prio_work_submit(struct prio_work *pw, k_timeout_t deadline);
+
+/* Print runs and missed deadlines of all registered types */
+void prio_wq_dump(void);
+
+/* Zero the counters of all registered types */
+void prio_wq_reset(void);
+
+#endif /* PRIO_WQ_H_ */
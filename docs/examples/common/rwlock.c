@@ -0,0 +1,154 @@
+/*
+ * Reader-Writer Lock
+ *
+ * All sleeping goes through one mutex and two condition variables.
+ * A thread about to sleep re-checks the state word while holding the
+ * mutex, and every release that may unblock someone changes the state
+ * word first and then signals under the same mutex, so no wakeup is
+ * lost between the check and the wait.
+ */
+
+#include "rwlock.h"
+
+#define RW_READER_MASK	 0xffff
+#define RW_WRITER	 BIT(16)
+#define RW_WAITER_SHIFT	 17
+#define RW_WAITER_ONE	 BIT(RW_WAITER_SHIFT)
+
+void rwlock_init(struct rwlock *rw)
+{
+	atomic_set(&rw->state, 0);
+	k_mutex_init(&rw->lock);
+	k_condvar_init(&rw->readers_cv);
+	k_condvar_init(&rw->writer_cv);
+	atomic_set(&rw->readers_waiting, 0);
+	atomic_set(&rw->read_waits, 0);
+	atomic_set(&rw->write_waits, 0);
+}
+
+/* Enter as a reader if no writer holds or waits for the lock */
+static bool try_read(struct rwlock *rw)
+{
+	atomic_val_t old = atomic_get(&rw->state);
+
+	while ((old & ~RW_READER_MASK) == 0) {
+		__ASSERT((old & RW_READER_MASK) != RW_READER_MASK,
+			 "too many readers");
+		if (atomic_cas(&rw->state, old, old + 1)) {
+			return true;
+		}
+		old = atomic_get(&rw->state);
+	}
+
+	return false;
+}
+
+/* Enter as a writer once nobody holds the lock; @p waiting drops one waiter */
+static bool try_write(struct rwlock *rw, bool waiting)
+{
+	atomic_val_t old = atomic_get(&rw->state);
+
+	while ((old & (RW_READER_MASK | RW_WRITER)) == 0) {
+		atomic_val_t new = old + RW_WRITER - (waiting ? RW_WAITER_ONE : 0);
+
+		if (atomic_cas(&rw->state, old, new)) {
+			return true;
+		}
+		old = atomic_get(&rw->state);
+	}
+
+	return false;
+}
+
+int rwlock_read_lock(struct rwlock *rw, k_timeout_t timeout)
+{
+	if (try_read(rw)) {
+		return 0;
+	}
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret = 0;
+
+	atomic_inc(&rw->read_waits);
+	k_mutex_lock(&rw->lock, K_FOREVER);
+	atomic_inc(&rw->readers_waiting);
+	while (!try_read(rw)) {
+		if (k_condvar_wait(&rw->readers_cv, &rw->lock,
+				   sys_timepoint_timeout(end)) != 0) {
+			ret = -EAGAIN;
+			break;
+		}
+	}
+	atomic_dec(&rw->readers_waiting);
+	k_mutex_unlock(&rw->lock);
+
+	return ret;
+}
+
+void rwlock_read_unlock(struct rwlock *rw)
+{
+	atomic_val_t old = atomic_dec(&rw->state);
+
+	/* Last reader out hands over to a waiting writer */
+	if ((old & RW_READER_MASK) == 1 && (old >> RW_WAITER_SHIFT) != 0) {
+		k_mutex_lock(&rw->lock, K_FOREVER);
+		k_condvar_signal(&rw->writer_cv);
+		k_mutex_unlock(&rw->lock);
+	}
+}
+
+int rwlock_write_lock(struct rwlock *rw, k_timeout_t timeout)
+{
+	if (try_write(rw, false)) {
+		return 0;
+	}
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret = 0;
+
+	atomic_inc(&rw->write_waits);
+	k_mutex_lock(&rw->lock, K_FOREVER);
+
+	/* From here on new readers stay out */
+	atomic_add(&rw->state, RW_WAITER_ONE);
+	while (!try_write(rw, true)) {
+		if (k_condvar_wait(&rw->writer_cv, &rw->lock,
+				   sys_timepoint_timeout(end)) != 0) {
+			atomic_sub(&rw->state, RW_WAITER_ONE);
+			/* Readers held back only by us may go now */
+			if (atomic_get(&rw->readers_waiting) > 0) {
+				k_condvar_broadcast(&rw->readers_cv);
+			}
+			ret = -EAGAIN;
+			break;
+		}
+	}
+	k_mutex_unlock(&rw->lock);
+
+	return ret;
+}
+
+void rwlock_write_unlock(struct rwlock *rw)
+{
+	atomic_val_t old = atomic_sub(&rw->state, RW_WRITER);
+
+	if ((old >> RW_WAITER_SHIFT) == 0 &&
+	    atomic_get(&rw->readers_waiting) == 0) {
+		return;
+	}
+
+	k_mutex_lock(&rw->lock, K_FOREVER);
+	if ((old >> RW_WAITER_SHIFT) != 0) {
+		k_condvar_signal(&rw->writer_cv);
+	}
+	if (atomic_get(&rw->readers_waiting) > 0) {
+		k_condvar_broadcast(&rw->readers_cv);
+	}
+	k_mutex_unlock(&rw->lock);
+}
@@ -0,0 +1,54 @@
+/*
+ * Reader-Writer Lock
+ *
+ * Many readers or one writer. Readers take the lock with a single
+ * compare-and-swap on a state word and never touch a kernel object
+ * unless a writer holds or is waiting for the lock, so concurrent
+ * readers do not serialize on each other. Waiting writers block new
+ * readers (writer preference), so a steady stream of readers cannot
+ * starve an update. Not recursive, and a reader may not upgrade.
+ * Initialize with rwlock_init() before first use, from main() or a
+ * SYS_INIT hook when threads or shell commands may get there first.
+ */
+
+#ifndef RWLOCK_H_
+#define RWLOCK_H_
+
+#include <zephyr/kernel.h>
+
+struct rwlock {
+	/* Readers in bits 0-15, writer bit 16, waiting writers above */
+	atomic_t state;
+
+	/* Slow path only */
+	struct k_mutex lock;
+	struct k_condvar readers_cv;
+	struct k_condvar writer_cv;
+	atomic_t readers_waiting;	/* changed only under lock */
+
+	/* Acquisitions that had to sleep */
+	atomic_t read_waits;
+	atomic_t write_waits;
+};
+
+void rwlock_init(struct rwlock *rw);
+
+/**
+ * Take the lock shared.
+ *
+ * @retval 0 Lock taken.
+ * @retval -EAGAIN A writer held the lock for the whole timeout.
+ */
+int rwlock_read_lock(struct rwlock *rw, k_timeout_t timeout);
+void rwlock_read_unlock(struct rwlock *rw);
+
+/**
+ * Take the lock exclusive.
+ *
+ * @retval 0 Lock taken.
+ * @retval -EAGAIN Readers or another writer held it for the whole timeout.
+ */
+int rwlock_write_lock(struct rwlock *rw, k_timeout_t timeout);
+void rwlock_write_unlock(struct rwlock *rw);
+
+#endif /* RWLOCK_H_ */
@@ -0,0 +1,254 @@
+/*
+ * Thread Monitor
+ *
+ * CPU shares are per-thread runtime cycle deltas divided by the
+ * hardware cycles elapsed between two samples, so on a single CPU the
+ * column adds up to 100% including the idle thread. Unused stack comes
+ * from k_thread_stack_space_get(), which scans for the fill pattern
+ * written by CONFIG_INIT_STACKS. That scan is why the thread list is
+ * walked with k_thread_foreach_unlocked(). The elapsed cycles come from
+ * cycle_stamp_get(), as k_cycle_get_64() is missing on SysTick boards.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cycle_stamp.h"
+#include "thread_mon.h"
+
+LOG_MODULE_REGISTER(thread_mon, LOG_LEVEL_INF);
+
+#define MON_STACK_SIZE 1024
+#define MON_PRIORITY K_LOWEST_APPLICATION_THREAD_PRIO
+
+static struct thread_mon_entry entries[THREAD_MON_MAX_THREADS];
+static bool seen[THREAD_MON_MAX_THREADS];
+static size_t entry_count;
+static uint64_t last_sample_cycles;
+static K_MUTEX_DEFINE(table_lock);
+
+K_THREAD_STACK_DEFINE(mon_stack, MON_STACK_SIZE);
+static struct k_thread mon_thread;
+static k_tid_t mon_tid;
+static k_timeout_t mon_period;
+static atomic_t mon_running;
+
+static struct thread_mon_entry *find_or_add(const struct k_thread *thread,
+					    uint64_t cycles)
+{
+	for (size_t i = 0; i < entry_count; i++) {
+		if (entries[i].thread == thread) {
+			seen[i] = true;
+			return &entries[i];
+		}
+	}
+
+	if (entry_count == ARRAY_SIZE(entries)) {
+		return NULL;
+	}
+
+	struct thread_mon_entry *e = &entries[entry_count];
+	const char *name = k_thread_name_get((k_tid_t)thread);
+
+	*e = (struct thread_mon_entry){
+		.thread = thread,
+		.last_cycles = cycles,	/* first interval starts now */
+	};
+	if (name != NULL && name[0] != '\0') {
+		strncpy(e->name, name, sizeof(e->name) - 1);
+	} else {
+		snprintk(e->name, sizeof(e->name), "%p", (void *)thread);
+	}
+	seen[entry_count++] = true;
+
+	return e;
+}
+
+static void sample_thread(const struct k_thread *thread, void *user_data)
+{
+	uint64_t interval = *(uint64_t *)user_data;
+	k_thread_runtime_stats_t stats;
+	struct thread_mon_entry *e;
+	size_t unused;
+
+	if (k_thread_runtime_stats_get((k_tid_t)thread, &stats) != 0) {
+		return;
+	}
+
+	e = find_or_add(thread, stats.execution_cycles);
+	if (e == NULL) {
+		return;
+	}
+
+	uint64_t delta = stats.execution_cycles - e->last_cycles;
+
+	e->cpu_x10 = interval ? (uint32_t)(delta * 1000 / interval) : 0;
+	e->last_cycles = stats.execution_cycles;
+
+	e->stack_size = thread->stack_info.size;
+	if (k_thread_stack_space_get(thread, &unused) == 0) {
+		e->stack_used = e->stack_size - unused;
+	}
+}
+
+/* Drop threads that have exited since the previous sample */
+static void compact(void)
+{
+	size_t out = 0;
+
+	for (size_t i = 0; i < entry_count; i++) {
+		if (seen[i]) {
+			entries[out++] = entries[i];
+		}
+	}
+	entry_count = out;
+}
+
+static void log_table(void)
+{
+	LOG_INF("%-16s %6s %12s %8s", "thread", "cpu%", "stack used",
+		"suggest");
+
+	for (size_t i = 0; i < entry_count; i++) {
+		const struct thread_mon_entry *e = &entries[i];
+
+		LOG_INF("%-16s %4u.%u %5zu/%-6zu %8zu", e->name,
+			e->cpu_x10 / 10, e->cpu_x10 % 10, e->stack_used,
+			e->stack_size, thread_mon_suggest_stack(e->stack_used));
+	}
+}
+
+void thread_mon_print(void)
+{
+	k_mutex_lock(&table_lock, K_FOREVER);
+
+	printk("%-16s %6s %12s %8s\n", "thread", "cpu%", "stack used",
+	       "suggest");
+	for (size_t i = 0; i < entry_count; i++) {
+		const struct thread_mon_entry *e = &entries[i];
+
+		printk("%-16s %4u.%u %5zu/%-6zu %8zu\n", e->name,
+		       e->cpu_x10 / 10, e->cpu_x10 % 10, e->stack_used,
+		       e->stack_size, thread_mon_suggest_stack(e->stack_used));
+	}
+
+	k_mutex_unlock(&table_lock);
+}
+
+void thread_mon_sample(void)
+{
+	k_mutex_lock(&table_lock, K_FOREVER);
+
+	uint64_t now = cycle_stamp_get();
+	uint64_t interval = last_sample_cycles ? now - last_sample_cycles : 0;
+
+	last_sample_cycles = now;
+	memset(seen, 0, sizeof(seen));
+	k_thread_foreach_unlocked(sample_thread, &interval);
+	compact();
+	log_table();
+
+	k_mutex_unlock(&table_lock);
+}
+
+static void mon_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&mon_running)) {
+		thread_mon_sample();
+		/* thread_mon_stop() and period changes wake us early */
+		k_sleep(mon_period);
+	}
+}
+
+void thread_mon_start(k_timeout_t period)
+{
+	mon_period = period;
+
+	if (atomic_cas(&mon_running, 0, 1)) {
+		mon_tid = k_thread_create(&mon_thread, mon_stack,
+					  K_THREAD_STACK_SIZEOF(mon_stack),
+					  mon_entry, NULL, NULL, NULL,
+					  MON_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(mon_tid, "thread_mon");
+	} else {
+		k_wakeup(mon_tid);
+	}
+}
+
+void thread_mon_stop(void)
+{
+	if (!atomic_cas(&mon_running, 1, 0)) {
+		return;
+	}
+
+	k_wakeup(mon_tid);
+	k_thread_join(&mon_thread, K_FOREVER);
+}
+
+/* ---- Shell commands ---- */
+
+#ifdef CONFIG_SHELL
+
+static int cmd_threadmon_show(const struct shell *sh, size_t argc,
+			      char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&table_lock, K_FOREVER);
+
+	shell_print(sh, "%-16s %6s %12s %8s", "thread", "cpu%",
+		    "stack used", "suggest");
+	for (size_t i = 0; i < entry_count; i++) {
+		const struct thread_mon_entry *e = &entries[i];
+
+		shell_print(sh, "%-16s %4u.%u %5zu/%-6zu %8zu", e->name,
+			    e->cpu_x10 / 10, e->cpu_x10 % 10, e->stack_used,
+			    e->stack_size,
+			    thread_mon_suggest_stack(e->stack_used));
+	}
+
+	k_mutex_unlock(&table_lock);
+	return 0;
+}
+
+static int cmd_threadmon_period(const struct shell *sh, size_t argc,
+				char **argv)
+{
+	int ms = atoi(argv[1]);
+
+	if (ms == 0) {
+		thread_mon_stop();
+		shell_print(sh, "Thread monitor stopped");
+		return 0;
+	}
+
+	if (ms < 100) {
+		shell_error(sh, "Period must be 0 (off) or >= 100 ms");
+		return -EINVAL;
+	}
+
+	thread_mon_start(K_MSEC(ms));
+	shell_print(sh, "Sampling threads every %d ms", ms);
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(threadmon_cmds,
+	SHELL_CMD(show, NULL, "Show the latest thread table",
+		  cmd_threadmon_show),
+	SHELL_CMD_ARG(period, NULL, "Set sampling period <ms|0>",
+		      cmd_threadmon_period, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(threadmon, &threadmon_cmds, "Thread CPU and stack monitor",
+		   NULL);
+
+#endif /* CONFIG_SHELL */
@@ -0,0 +1,52 @@
+/*
+ * Thread Monitor
+ *
+ * A low-priority thread that periodically samples every thread's
+ * runtime cycles and unused stack. For each interval it computes each
+ * thread's share of the CPU and logs a compact table that also shows
+ * the stack high-water mark and a suggested stack size (peak use plus
+ * 25%, rounded up to 64 bytes). With CONFIG_SHELL the latest table is
+ * also available as "threadmon show". Where the console is busy, e.g.
+ * carrying trace data, build without CONFIG_LOG so sampling is silent
+ * and print the table with thread_mon_print() once that is over.
+ *
+ * Requires CONFIG_THREAD_MONITOR, CONFIG_THREAD_RUNTIME_STATS,
+ * CONFIG_THREAD_STACK_INFO and CONFIG_INIT_STACKS.
+ */
+
+#ifndef THREAD_MON_H_
+#define THREAD_MON_H_
+
+#include <zephyr/kernel.h>
+
+/* Threads tracked at once; extra threads are left out of the table */
+#define THREAD_MON_MAX_THREADS 16
+
+struct thread_mon_entry {
+	const struct k_thread *thread;
+	char name[16];
+	uint64_t last_cycles;	/* runtime cycles at the previous sample */
+	uint32_t cpu_x10;	/* share of the last interval, in 0.1% */
+	size_t stack_size;
+	size_t stack_used;	/* high-water mark since thread start */
+};
+
+/* Start sampling every @p period; restarts with the new period if running */
+void thread_mon_start(k_timeout_t period);
+
+/* Stop the monitor thread; the last table stays available */
+void thread_mon_stop(void);
+
+/* Take one sample now and log the table */
+void thread_mon_sample(void);
+
+/* Print the latest table with printk */
+void thread_mon_print(void);
+
+/* Stack size to configure for a thread that peaked at @p used bytes */
+static inline size_t thread_mon_suggest_stack(size_t used)
+{
+	return ROUND_UP(used + used / 4, 64);
+}
+
+#endif /* THREAD_MON_H_ */
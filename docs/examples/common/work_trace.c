@@ -0,0 +1,204 @@
+/*
+ * Work Item Latency Tracer
+ *
+ * Each traced item is initialized with a trampoline as its handler.
+ * work_trace_schedule() records the cycle count at which the item is
+ * due, the trampoline takes the difference to its own start as the
+ * queue wait and times the real handler around the call. The due stamp
+ * is written only when the item is not already delayed or queued, since
+ * then k_work_schedule() leaves the item's original timing in place. A
+ * running item does not count: a resubmit from its own handler starts a
+ * new wait. A submission that races with the item's own start can
+ * still mix up the two stamps; that costs one sample, not correctness.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "work_trace.h"
+
+static sys_slist_t traces = SYS_SLIST_STATIC_INIT(&traces);
+static struct k_spinlock lock;
+
+static void register_once(struct work_trace *trace)
+{
+	if (atomic_get(&trace->registered) != 0 ||
+	    !atomic_cas(&trace->registered, 0, 1)) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&traces, &trace->node);
+	k_spin_unlock(&lock, key);
+}
+
+static void trampoline(struct k_work *work)
+{
+	struct work_trace_item *item = work_trace_item_from_work(work);
+	struct work_trace *trace = item->trace;
+	uint32_t start = k_cycle_get_32();
+	int32_t late = (int32_t)(start - item->due);
+
+	trace->handler(work);
+
+	uint32_t wait_us = k_cyc_to_us_floor32(MAX(late, 0));
+	uint32_t run_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	lat_hist_add(&trace->wait, wait_us);
+	lat_hist_add(&trace->run, run_us);
+
+	k_spin_unlock(&lock, key);
+}
+
+void work_trace_init(struct work_trace_item *item, struct work_trace *trace)
+{
+	item->trace = trace;
+	item->due = 0;
+	k_work_init_delayable(&item->dwork, trampoline);
+}
+
+int work_trace_schedule(struct work_trace_item *item, k_timeout_t delay)
+{
+	register_once(item->trace);
+
+	/* k_work_delayable_is_pending() would include RUNNING */
+	if ((k_work_delayable_busy_get(&item->dwork) &
+	     (K_WORK_DELAYED | K_WORK_QUEUED)) == 0) {
+		item->due = k_cycle_get_32() +
+			k_ticks_to_cyc_floor32((uint32_t)delay.ticks);
+	}
+
+	return k_work_schedule(&item->dwork, delay);
+}
+
+/* Copy under the lock so a line never mixes two updates */
+static void snapshot(const struct work_trace *trace, struct work_trace *copy)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*copy = *trace;
+	k_spin_unlock(&lock, key);
+}
+
+void work_trace_dump(void)
+{
+	struct work_trace *trace;
+	struct work_trace t;
+
+	printk("%-24s %6s %8s %8s %8s %8s %8s %8s\n", "handler", "runs",
+	       "wait p50", "p99", "max", "run p50", "p99", "max");
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&traces, trace, node) {
+		snapshot(trace, &t);
+		printk("%-24s %6u %8u %8u %8u %8u %8u %8u\n", t.name,
+		       t.run.count, lat_hist_percentile(&t.wait, 500),
+		       lat_hist_percentile(&t.wait, 990), t.wait.max,
+		       lat_hist_percentile(&t.run, 500),
+		       lat_hist_percentile(&t.run, 990), t.run.max);
+	}
+}
+
+/*
+ * Traces are only ever appended, so the list can be walked without the
+ * lock; each trace is cleared under it.
+ */
+void work_trace_reset(void)
+{
+	struct work_trace *trace;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&traces, trace, node) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		memset(&trace->wait, 0, sizeof(trace->wait));
+		memset(&trace->run, 0, sizeof(trace->run));
+
+		k_spin_unlock(&lock, key);
+	}
+}
+
+/* ---- Shell commands ---- */
+
+#ifdef CONFIG_SHELL
+
+static int cmd_worktrace_show(const struct shell *sh, size_t argc,
+			      char **argv)
+{
+	struct work_trace *trace;
+	struct work_trace t;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&traces, trace, node) {
+		if (argc > 1 && strcmp(trace->name, argv[1]) != 0) {
+			continue;
+		}
+
+		snapshot(trace, &t);
+		shell_print(sh, "%s: %u runs, wait max %u us, run max %u us",
+			    t.name, t.run.count, t.wait.max, t.run.max);
+		shell_print(sh, "  %10s %10s %8s %8s", "from us", "to us",
+			    "wait", "run");
+
+		for (size_t b = 0; b < LAT_HIST_BUCKETS; b++) {
+			if (t.wait.buckets[b] == 0 && t.run.buckets[b] == 0) {
+				continue;
+			}
+
+			shell_print(sh, "  %10u %10u %8u %8u",
+				    b == 0 ? 0 : (uint32_t)BIT(b - 1),
+				    b == 0 ? 0 : (uint32_t)BIT(b) - 1,
+				    t.wait.buckets[b], t.run.buckets[b]);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_worktrace_summary(const struct shell *sh, size_t argc,
+				 char **argv)
+{
+	struct work_trace *trace;
+	struct work_trace t;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "%-24s %6s %8s %8s %8s %8s", "handler", "runs",
+		    "wait p99", "max", "run p99", "max");
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&traces, trace, node) {
+		snapshot(trace, &t);
+		shell_print(sh, "%-24s %6u %8u %8u %8u %8u", t.name,
+			    t.run.count, lat_hist_percentile(&t.wait, 990),
+			    t.wait.max, lat_hist_percentile(&t.run, 990),
+			    t.run.max);
+	}
+
+	return 0;
+}
+
+static int cmd_worktrace_reset(const struct shell *sh, size_t argc,
+			       char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	work_trace_reset();
+	shell_print(sh, "Work trace histograms reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(worktrace_cmds,
+	SHELL_CMD(summary, NULL, "One line per handler", cmd_worktrace_summary),
+	SHELL_CMD_ARG(show, NULL, "Show histograms [handler]",
+		      cmd_worktrace_show, 1, 1),
+	SHELL_CMD(reset, NULL, "Reset all histograms", cmd_worktrace_reset),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(worktrace, &worktrace_cmds, "Work item latency tracer",
+		   NULL);
+
+#endif /* CONFIG_SHELL */
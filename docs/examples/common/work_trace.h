@@ -0,0 +1,108 @@
+/*
+ * Work Item Latency Tracer
+ *
+ * Opt-in timing for work items: how long each item waited in the queue
+ * after it was due (submit-to-start) and how long its handler ran. Both
+ * go into log2 histograms kept per handler function, so a handler that
+ * starves the queue shows up as a long run time on its own line and as
+ * long waits on everyone else's. A traced item wraps a delayable work
+ * item and is submitted through the tracer:
+ *
+ *   static void sample_handler(struct k_work *work);
+ *   WORK_TRACE_DEFINE(sample_handler);
+ *   static struct work_trace_item sample_work;
+ *
+ *   work_trace_init(&sample_work, &sample_handler_trace);
+ *   work_trace_submit(&sample_work);             (like k_work_submit)
+ *   work_trace_schedule(&sample_work, K_MSEC(5)); (like k_work_schedule)
+ *
+ * Traces register on first use. Results are available with
+ * work_trace_dump() and, with CONFIG_SHELL, the "worktrace" command.
+ *
+ * Tracing is compiled in only when WORK_TRACE_ENABLED is defined (the
+ * WORK_TRACE CMake option). Otherwise the calls are plain k_work calls.
+ */
+
+#ifndef WORK_TRACE_H_
+#define WORK_TRACE_H_
+
+#include <zephyr/kernel.h>
+
+#include "lat_hist.h"
+
+struct work_trace {
+	k_work_handler_t handler;
+	const char *name;
+#ifdef WORK_TRACE_ENABLED
+	sys_snode_t node;
+	atomic_t registered;
+
+	/* In us, updated under the tracer's lock; one sample per run */
+	struct lat_hist wait;
+	struct lat_hist run;
+#endif
+};
+
+/* Define the trace <handler>_trace for the handler function @p _handler */
+#define WORK_TRACE_DEFINE(_handler)                                        \
+	static struct work_trace _handler##_trace = {                      \
+		.handler = _handler,                                       \
+		.name = #_handler,                                         \
+	}
+
+struct work_trace_item {
+	struct k_work_delayable dwork;
+	struct work_trace *trace;
+#ifdef WORK_TRACE_ENABLED
+	uint32_t due;		/* cycle count at which it may run */
+#endif
+};
+
+static inline struct work_trace_item *work_trace_item_from_work(
+	struct k_work *work)
+{
+	return CONTAINER_OF(k_work_delayable_from_work(work),
+			    struct work_trace_item, dwork);
+}
+
+#ifdef WORK_TRACE_ENABLED
+
+/* k_work_init_delayable() for an item whose handler is traced by @p trace */
+void work_trace_init(struct work_trace_item *item, struct work_trace *trace);
+
+/* k_work_schedule() that timestamps when the item becomes due */
+int work_trace_schedule(struct work_trace_item *item, k_timeout_t delay);
+
+/* Print one summary line per registered handler */
+void work_trace_dump(void);
+
+/* Zero the histograms of all registered handlers */
+void work_trace_reset(void);
+
+#else
+
+static inline void work_trace_init(struct work_trace_item *item,
+				   struct work_trace *trace)
+{
+	item->trace = trace;
+	k_work_init_delayable(&item->dwork, trace->handler);
+}
+
+static inline int work_trace_schedule(struct work_trace_item *item,
+				      k_timeout_t delay)
+{
+	return k_work_schedule(&item->dwork, delay);
+}
+
+static inline void work_trace_dump(void) {}
+static inline void work_trace_reset(void) {}
+
+#endif /* WORK_TRACE_ENABLED */
+
+/* k_work_submit() for a traced item */
+static inline int work_trace_submit(struct work_trace_item *item)
+{
+	return work_trace_schedule(item, K_NO_WAIT);
+}
+
+#endif /* WORK_TRACE_H_ */
@@ -0,0 +1,28 @@
+/*
+ * Arena (Region) Allocator
+ */
+
+#include "arena.h"
+
+void arena_init(struct arena *arena, void *buf, size_t size)
+{
+	*arena = (struct arena){ .base = buf, .size = size };
+}
+
+void *arena_alloc_aligned(struct arena *arena, size_t size, size_t align)
+{
+	__ASSERT(IS_POWER_OF_TWO(align), "alignment must be a power of two");
+
+	uintptr_t start = ROUND_UP((uintptr_t)arena->base + arena->used, align);
+	size_t offset = start - (uintptr_t)arena->base;
+
+	if (offset > arena->size || size > arena->size - offset) {
+		arena->failures++;
+		return NULL;
+	}
+
+	arena->used = offset + size;
+	arena->peak = MAX(arena->peak, arena->used);
+
+	return (void *)start;
+}
@@ -0,0 +1,67 @@
+/*
+ * Arena (Region) Allocator
+ *
+ * Hands out memory from a static buffer by bumping a pointer, and
+ * releases everything at once with arena_reset() (or back to a saved
+ * mark). Intended for transient data built during one processing
+ * cycle. An arena is not thread-safe; give each thread its own.
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <zephyr/kernel.h>
+
+/* Default alignment of arena_alloc() results */
+#define ARENA_ALIGN 8
+
+struct arena {
+	uint8_t *base;
+	size_t size;
+	size_t used;
+
+	/* Highest 'used' value seen and number of refused requests */
+	size_t peak;
+	uint32_t failures;
+};
+
+/* Define a static arena @p name backed by @p bytes of storage */
+#define ARENA_DEFINE(name, bytes)					\
+	static uint8_t __aligned(ARENA_ALIGN) name##_buf[bytes];	\
+	static struct arena name = {					\
+		.base = name##_buf,					\
+		.size = bytes,						\
+	}
+
+void arena_init(struct arena *arena, void *buf, size_t size);
+
+/* O(1) allocation; returns NULL when the arena is exhausted */
+void *arena_alloc_aligned(struct arena *arena, size_t size, size_t align);
+
+static inline void *arena_alloc(struct arena *arena, size_t size)
+{
+	return arena_alloc_aligned(arena, size, ARENA_ALIGN);
+}
+
+/* Release every allocation made since arena_init() or the last reset */
+static inline void arena_reset(struct arena *arena)
+{
+	arena->used = 0;
+}
+
+/*
+ * Scoped release: save a mark, make allocations, then roll back to the
+ * mark to free only those allocations.
+ */
+static inline size_t arena_mark(const struct arena *arena)
+{
+	return arena->used;
+}
+
+static inline void arena_release(struct arena *arena, size_t mark)
+{
+	__ASSERT(mark <= arena->used, "arena mark is newer than arena");
+	arena->used = mark;
+}
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,22 @@
+/*
+ * Memory Allocator Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so compare operation and failure counts there and
+ * use qemu or a real board for absolute latencies.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Size-class allocator vs plain k_heap_alloc under mixed-size churn */
+void bench_size_class(void);
+
+/* Multi-thread slab stress with and without per-thread caches */
+void bench_slab_cache(void);
+
+/* Arena reset vs k_malloc/k_free for per-cycle transient buffers */
+void bench_arena(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,136 @@
+/*
+ * Arena Allocator Benchmark
+ *
+ * Replays the allocate-use-free-all pattern of demo_system_heap() for
+ * many processing cycles: once with k_malloc/k_free per buffer, once
+ * with arena allocations and a single arena_reset() per cycle.
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "arena.h"
+#include "bench.h"
+
+#define ARENA_CYCLES 500
+#define MSG_LEN 64
+#define DATA_COUNT 10
+#define SAMPLE_BUFS 4
+#define SAMPLE_LEN 48
+
+/* Enough for one cycle: message, int array and sample buffers */
+ARENA_DEFINE(cycle_arena, 512);
+
+struct cycle_bufs {
+	char *msg;
+	int *data;
+	uint8_t *samples[SAMPLE_BUFS];
+};
+
+/* Touch every buffer so both variants do the same work */
+static int use_buffers(struct cycle_bufs *b, int cycle)
+{
+	int sum = 0;
+
+	snprintf(b->msg, MSG_LEN, "cycle %d on %s", cycle, CONFIG_BOARD);
+	for (int i = 0; i < DATA_COUNT; i++) {
+		b->data[i] = i * i + cycle;
+		sum += b->data[i];
+	}
+	for (int i = 0; i < SAMPLE_BUFS; i++) {
+		memset(b->samples[i], cycle & 0xff, SAMPLE_LEN);
+		sum += b->samples[i][0];
+	}
+
+	return sum;
+}
+
+static bool malloc_cycle(int cycle)
+{
+	struct cycle_bufs b = { 0 };
+	bool ok;
+
+	b.msg = k_malloc(MSG_LEN);
+	b.data = k_malloc(DATA_COUNT * sizeof(int));
+	for (int i = 0; i < SAMPLE_BUFS; i++) {
+		b.samples[i] = k_malloc(SAMPLE_LEN);
+	}
+
+	ok = b.msg && b.data;
+	for (int i = 0; i < SAMPLE_BUFS; i++) {
+		ok = ok && b.samples[i];
+	}
+	if (ok) {
+		use_buffers(&b, cycle);
+	}
+
+	/* k_free(NULL) is a no-op, so partial failures clean up too */
+	for (int i = SAMPLE_BUFS - 1; i >= 0; i--) {
+		k_free(b.samples[i]);
+	}
+	k_free(b.data);
+	k_free(b.msg);
+
+	return ok;
+}
+
+static bool arena_cycle(int cycle)
+{
+	struct cycle_bufs b;
+	bool ok;
+
+	b.msg = arena_alloc(&cycle_arena, MSG_LEN);
+	b.data = arena_alloc(&cycle_arena, DATA_COUNT * sizeof(int));
+	for (int i = 0; i < SAMPLE_BUFS; i++) {
+		b.samples[i] = arena_alloc(&cycle_arena, SAMPLE_LEN);
+	}
+
+	ok = b.msg && b.data;
+	for (int i = 0; i < SAMPLE_BUFS; i++) {
+		ok = ok && b.samples[i];
+	}
+	if (ok) {
+		use_buffers(&b, cycle);
+	}
+
+	/* One reset frees the whole cycle */
+	arena_reset(&cycle_arena);
+
+	return ok;
+}
+
+static void run_cycles(const char *name, bool (*cycle_fn)(int))
+{
+	uint32_t total = 0, max = 0, failed = 0;
+
+	for (int i = 0; i < ARENA_CYCLES; i++) {
+		uint32_t start = k_cycle_get_32();
+		bool ok = cycle_fn(i);
+		uint32_t cycles = k_cycle_get_32() - start;
+
+		total += cycles;
+		max = MAX(max, cycles);
+		if (!ok) {
+			failed++;
+		}
+	}
+
+	printk("%-10s %10u %10u %6u\n", name, total / ARENA_CYCLES, max,
+	       failed);
+}
+
+void bench_arena(void)
+{
+	printk("\n--- Benchmark: arena vs k_malloc/k_free ---\n");
+	printk("%d cycles, %d allocations per cycle\n",
+	       ARENA_CYCLES, 2 + SAMPLE_BUFS);
+	printk("%-10s %10s %10s %6s\n", "allocator", "avg cyc", "max cyc",
+	       "fail");
+
+	run_cycles("k_malloc", malloc_cycle);
+	run_cycles("arena", arena_cycle);
+
+	printk("Arena peak use: %zu of %zu bytes, %u failures\n",
+	       cycle_arena.peak, cycle_arena.size, cycle_arena.failures);
+}
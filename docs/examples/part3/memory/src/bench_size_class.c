@@ -0,0 +1,139 @@
+/*
+ * Size-Class Allocator Benchmark
+ *
+ * Runs the same mixed-size allocate/free churn against the size-class
+ * allocator and against a plain k_heap holding the same total memory.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "size_class.h"
+#include "bench.h"
+
+#define CHURN_SLOTS 24
+#define CHURN_ITERATIONS 4000
+
+/* Slab memory (4608 bytes) plus the 1024-byte fallback heap */
+K_HEAP_DEFINE(churn_heap, 4608 + 1024);
+
+/* Request sizes seen in the sensor pipelines, mostly small */
+static const uint16_t churn_sizes[] = {
+	16, 24, 40, 64, 64, 96, 128, 128, 200, 256, 320, 512,
+};
+
+struct churn_result {
+	uint32_t allocs;
+	uint32_t failures;
+	uint32_t frees;
+	uint32_t alloc_cycles;
+	uint32_t alloc_max;
+	uint32_t free_cycles;
+	uint32_t free_max;
+};
+
+/* Small deterministic PRNG so both runs see the same request stream */
+static uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static void *heap_alloc(size_t size)
+{
+	return k_heap_alloc(&churn_heap, size, K_NO_WAIT);
+}
+
+static void heap_free(void *ptr)
+{
+	k_heap_free(&churn_heap, ptr);
+}
+
+static void *sc_alloc(size_t size)
+{
+	return size_class_alloc(size, K_NO_WAIT);
+}
+
+static void run_churn(void *(*alloc_fn)(size_t), void (*free_fn)(void *),
+		      struct churn_result *res)
+{
+	void *slots[CHURN_SLOTS] = { 0 };
+	uint32_t seed = 0x2545f491;
+
+	memset(res, 0, sizeof(*res));
+
+	for (int i = 0; i < CHURN_ITERATIONS; i++) {
+		uint32_t r = xorshift32(&seed);
+		int slot = r % CHURN_SLOTS;
+		uint32_t start, cycles;
+
+		if (slots[slot] != NULL) {
+			start = k_cycle_get_32();
+			free_fn(slots[slot]);
+			cycles = k_cycle_get_32() - start;
+
+			slots[slot] = NULL;
+			res->frees++;
+			res->free_cycles += cycles;
+			res->free_max = MAX(res->free_max, cycles);
+			continue;
+		}
+
+		size_t size = churn_sizes[(r >> 8) % ARRAY_SIZE(churn_sizes)];
+
+		start = k_cycle_get_32();
+		slots[slot] = alloc_fn(size);
+		cycles = k_cycle_get_32() - start;
+
+		res->alloc_cycles += cycles;
+		res->alloc_max = MAX(res->alloc_max, cycles);
+		if (slots[slot] != NULL) {
+			res->allocs++;
+		} else {
+			res->failures++;
+		}
+	}
+
+	for (int i = 0; i < CHURN_SLOTS; i++) {
+		if (slots[i] != NULL) {
+			free_fn(slots[i]);
+		}
+	}
+}
+
+static void print_result(const char *name, const struct churn_result *res)
+{
+	uint32_t attempts = res->allocs + res->failures;
+
+	printk("%-10s %6u %6u %10u %10u %10u %10u\n", name,
+	       res->allocs, res->failures,
+	       attempts ? res->alloc_cycles / attempts : 0, res->alloc_max,
+	       res->frees ? res->free_cycles / res->frees : 0, res->free_max);
+}
+
+void bench_size_class(void)
+{
+	struct churn_result heap_res, sc_res;
+
+	printk("\n--- Benchmark: size-class vs k_heap ---\n");
+	printk("%d iterations over %d live slots, sizes 16-512 bytes\n",
+	       CHURN_ITERATIONS, CHURN_SLOTS);
+
+	run_churn(heap_alloc, heap_free, &heap_res);
+
+	size_class_stats_reset();
+	run_churn(sc_alloc, size_class_free, &sc_res);
+
+	printk("%-10s %6s %6s %10s %10s %10s %10s\n", "allocator",
+	       "ok", "fail", "alloc avg", "alloc max", "free avg", "free max");
+	print_result("k_heap", &heap_res);
+	print_result("size-class", &sc_res);
+
+	printk("Size-class breakdown:\n");
+	size_class_stats_print();
+}
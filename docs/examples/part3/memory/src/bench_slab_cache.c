@@ -0,0 +1,175 @@
+/*
+ * Slab Cache Stress Benchmark
+ *
+ * Several threads allocate, fill and free struct sensor_data blocks
+ * from one shared slab, first calling k_mem_slab_alloc/free directly
+ * and then through per-thread slab caches.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "lat_hist.h"
+#include "sensor_data.h"
+#include "slab_cache.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define STRESS_THREADS 4
+#define STRESS_ITERATIONS 2000
+#define STRESS_HOLD 3		/* blocks in flight per iteration */
+#define STRESS_YIELD_EVERY 16	/* interleave threads on the slab */
+
+/* Pointer-aligned blocks so the depot can chain them */
+K_MEM_SLAB_DEFINE_STATIC(stress_slab, 32, 64, 8);
+
+K_THREAD_STACK_ARRAY_DEFINE(stress_stacks, STRESS_THREADS, STACK_SIZE);
+static struct k_thread stress_threads[STRESS_THREADS];
+
+static struct slab_depot stress_depot;
+
+struct stress_ctx {
+	struct slab_cache cache;
+	bool use_cache;
+	uint32_t failures;
+	struct lat_hist hist;	/* cycles per successful alloc */
+};
+
+static struct stress_ctx stress_ctx[STRESS_THREADS];
+
+static int alloc_block(struct stress_ctx *ctx, void **mem)
+{
+	if (ctx->use_cache) {
+		return slab_cache_alloc(&ctx->cache, mem, K_NO_WAIT);
+	}
+	return k_mem_slab_alloc(&stress_slab, mem, K_NO_WAIT);
+}
+
+static void free_block(struct stress_ctx *ctx, void *mem)
+{
+	if (ctx->use_cache) {
+		slab_cache_free(&ctx->cache, mem);
+	} else {
+		k_mem_slab_free(&stress_slab, mem);
+	}
+}
+
+static void stress_entry(void *p1, void *p2, void *p3)
+{
+	struct stress_ctx *ctx = p1;
+	uint8_t channel = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < STRESS_ITERATIONS; i++) {
+		void *blocks[STRESS_HOLD];
+		int held = 0;
+
+		for (int j = 0; j < STRESS_HOLD; j++) {
+			uint32_t start = k_cycle_get_32();
+			int ret = alloc_block(ctx, &blocks[held]);
+			uint32_t cycles = k_cycle_get_32() - start;
+
+			if (ret != 0) {
+				ctx->failures++;
+				continue;
+			}
+
+			struct sensor_data *data = blocks[held++];
+
+			data->timestamp = k_uptime_get_32();
+			data->temperature = 2500 + j;
+			data->humidity = 600;
+			data->channel = channel;
+
+			lat_hist_add(&ctx->hist, cycles);
+		}
+
+		while (held > 0) {
+			free_block(ctx, blocks[--held]);
+		}
+
+		if ((i % STRESS_YIELD_EVERY) == 0) {
+			k_yield();
+		}
+	}
+
+	if (ctx->use_cache) {
+		slab_cache_flush(&ctx->cache);
+	}
+}
+
+static void run_stress(bool use_cache)
+{
+	struct lat_hist hist = { 0 };
+	uint32_t failures = 0;
+	uint32_t hits = 0, refills = 0, drains = 0;
+
+	slab_depot_init(&stress_depot, &stress_slab);
+
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		struct stress_ctx *ctx = &stress_ctx[t];
+
+		memset(ctx, 0, sizeof(*ctx));
+		ctx->use_cache = use_cache;
+		slab_cache_init(&ctx->cache, &stress_depot);
+
+		k_thread_create(&stress_threads[t], stress_stacks[t],
+				K_THREAD_STACK_SIZEOF(stress_stacks[t]),
+				stress_entry, ctx, UINT_TO_POINTER(t), NULL,
+				5, 0, K_FOREVER);
+		k_thread_name_set(&stress_threads[t], "stress");
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		k_thread_start(&stress_threads[t]);
+	}
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		k_thread_join(&stress_threads[t], K_FOREVER);
+	}
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+
+	slab_depot_flush(&stress_depot);
+
+	for (int t = 0; t < STRESS_THREADS; t++) {
+		struct stress_ctx *ctx = &stress_ctx[t];
+
+		lat_hist_merge(&hist, &ctx->hist);
+		failures += ctx->failures;
+		hits += ctx->cache.hits;
+		refills += ctx->cache.refills;
+		drains += ctx->cache.drains;
+	}
+
+	uint64_t per_sec = elapsed ?
+		(uint64_t)hist.count * sys_clock_hw_cycles_per_sec() / elapsed : 0;
+
+	printk("%-8s %8u %5u %12llu %8u %8u %8u\n",
+	       use_cache ? "cache" : "direct", hist.count, failures,
+	       (unsigned long long)per_sec,
+	       lat_hist_percentile(&hist, 500),
+	       lat_hist_percentile(&hist, 990), hist.max);
+
+	if (use_cache) {
+		printk("  cache hits=%u refills=%u drains=%u\n",
+		       hits, refills, drains);
+	}
+}
+
+void bench_slab_cache(void)
+{
+	printk("\n--- Benchmark: per-thread slab cache ---\n");
+	printk("%d threads x %d iterations x %d blocks\n",
+	       STRESS_THREADS, STRESS_ITERATIONS, STRESS_HOLD);
+	printk("%-8s %8s %5s %12s %8s %8s %8s\n", "mode", "allocs", "fail",
+	       "allocs/s", "p50 cyc", "p99 cyc", "max cyc");
+
+	run_stress(false);
+	run_stress(true);
+
+	printk("Slab blocks in use after run: %u\n",
+	       k_mem_slab_num_used_get(&stress_slab));
+}
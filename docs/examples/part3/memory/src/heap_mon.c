@@ -0,0 +1,331 @@
+/*
+ * Heap Monitor
+ *
+ * Live bytes come from the sys_heap runtime stats (chunk-accurate,
+ * including allocator overhead). Peak is tracked here instead of
+ * using max_allocated_bytes, because the largest-free-block probe
+ * makes trial allocations that would otherwise inflate it. Only
+ * heap_mon_probe() and the "heapmon probe" command make those; the
+ * snapshot, log line and "heapmon show" read the stats only.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "heap_mon.h"
+
+LOG_MODULE_REGISTER(heap_mon, LOG_LEVEL_INF);
+
+static sys_slist_t monitors = SYS_SLIST_STATIC_INIT(&monitors);
+static K_MUTEX_DEFINE(monitors_lock);
+
+static int size_bucket(size_t bytes)
+{
+	if (bytes <= 16) {
+		return 0;
+	}
+
+	return CLAMP((int)find_msb_set(bytes - 1) - 4, 0, HEAP_MON_BUCKETS - 1);
+}
+
+static void update_peak(struct heap_mon *mon)
+{
+	struct sys_memory_stats stats;
+	atomic_val_t old;
+
+	sys_heap_runtime_stats_get(&mon->heap->heap, &stats);
+
+	do {
+		old = atomic_get(&mon->peak);
+		if ((size_t)old >= stats.allocated_bytes) {
+			break;
+		}
+	} while (!atomic_cas(&mon->peak, old, stats.allocated_bytes));
+}
+
+void heap_mon_init(struct heap_mon *mon, struct k_heap *heap,
+		   const char *name)
+{
+	mon->heap = heap;
+	mon->name = name;
+	heap_mon_reset(mon);
+
+	k_mutex_lock(&monitors_lock, K_FOREVER);
+	sys_slist_append(&monitors, &mon->node);
+	k_mutex_unlock(&monitors_lock);
+}
+
+void *heap_mon_alloc(struct heap_mon *mon, size_t bytes,
+		     k_timeout_t timeout)
+{
+	void *mem = k_heap_alloc(mon->heap, bytes, timeout);
+
+	atomic_inc(&mon->hist[size_bucket(bytes)]);
+
+	if (mem == NULL) {
+		atomic_inc(&mon->failures);
+		atomic_set(&mon->last_fail_size, bytes);
+		return NULL;
+	}
+
+	atomic_inc(&mon->allocs);
+	update_peak(mon);
+
+	return mem;
+}
+
+void heap_mon_free(struct heap_mon *mon, void *mem)
+{
+	if (mem == NULL) {
+		return;
+	}
+
+	k_heap_free(mon->heap, mem);
+	atomic_inc(&mon->frees);
+}
+
+/* Binary search for the biggest request the heap can satisfy now */
+static size_t probe_largest_free(struct k_heap *heap, size_t free_bytes)
+{
+	size_t lo = 0;
+	size_t hi = free_bytes;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo + 1) / 2;
+		void *mem = k_heap_alloc(heap, mid, K_NO_WAIT);
+
+		if (mem != NULL) {
+			k_heap_free(heap, mem);
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	return lo;
+}
+
+void heap_mon_snapshot(struct heap_mon *mon, struct heap_mon_snapshot *snap)
+{
+	struct sys_memory_stats stats;
+
+	sys_heap_runtime_stats_get(&mon->heap->heap, &stats);
+
+	snap->capacity = stats.free_bytes + stats.allocated_bytes;
+	snap->live = stats.allocated_bytes;
+	snap->peak = MAX((size_t)atomic_get(&mon->peak), stats.allocated_bytes);
+	snap->free = stats.free_bytes;
+	snap->largest_free = 0;
+	snap->frag_pct = 0;
+
+	snap->allocs = atomic_get(&mon->allocs);
+	snap->frees = atomic_get(&mon->frees);
+	snap->failures = atomic_get(&mon->failures);
+	snap->last_fail_size = atomic_get(&mon->last_fail_size);
+	for (int i = 0; i < HEAP_MON_BUCKETS; i++) {
+		snap->hist[i] = atomic_get(&mon->hist[i]);
+	}
+}
+
+void heap_mon_probe(struct heap_mon *mon, struct heap_mon_snapshot *snap)
+{
+	snap->largest_free = probe_largest_free(mon->heap, snap->free);
+	snap->frag_pct = snap->free ?
+		100 - (uint32_t)((snap->largest_free * 100) / snap->free) : 0;
+}
+
+void heap_mon_reset(struct heap_mon *mon)
+{
+	atomic_clear(&mon->allocs);
+	atomic_clear(&mon->frees);
+	atomic_clear(&mon->failures);
+	atomic_clear(&mon->last_fail_size);
+	atomic_clear(&mon->peak);
+	for (int i = 0; i < HEAP_MON_BUCKETS; i++) {
+		atomic_clear(&mon->hist[i]);
+	}
+
+	update_peak(mon);
+}
+
+/* ---- Periodic log line ---- */
+
+static k_timeout_t log_period;
+
+static void log_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(log_work, log_work_handler);
+
+static void log_work_handler(struct k_work *work)
+{
+	struct heap_mon *mon;
+	struct heap_mon_snapshot snap;
+
+	k_mutex_lock(&monitors_lock, K_FOREVER);
+	SYS_SLIST_FOR_EACH_CONTAINER(&monitors, mon, node) {
+		heap_mon_snapshot(mon, &snap);
+		LOG_INF("%s: live %zu peak %zu of %zu, fail %u",
+			mon->name, snap.live, snap.peak, snap.capacity,
+			snap.failures);
+	}
+	k_mutex_unlock(&monitors_lock);
+
+	k_work_schedule(k_work_delayable_from_work(work), log_period);
+}
+
+void heap_mon_log_start(k_timeout_t period)
+{
+	log_period = period;
+	k_work_reschedule(&log_work, period);
+}
+
+void heap_mon_log_stop(void)
+{
+	k_work_cancel_delayable(&log_work);
+}
+
+/* ---- Shell commands ---- */
+
+static struct heap_mon *find_monitor(const char *name)
+{
+	struct heap_mon *mon;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&monitors, mon, node) {
+		if (strcmp(mon->name, name) == 0) {
+			return mon;
+		}
+	}
+
+	return NULL;
+}
+
+static void print_monitor(const struct shell *sh, struct heap_mon *mon)
+{
+	struct heap_mon_snapshot snap;
+	size_t limit = 16;
+
+	heap_mon_snapshot(mon, &snap);
+
+	shell_print(sh, "%s:", mon->name);
+	shell_print(sh, "  capacity %zu, live %zu, peak %zu, free %zu",
+		    snap.capacity, snap.live, snap.peak, snap.free);
+	shell_print(sh, "  allocs %u, frees %u, failures %u (last %u bytes)",
+		    snap.allocs, snap.frees, snap.failures,
+		    snap.last_fail_size);
+
+	for (int i = 0; i < HEAP_MON_BUCKETS; i++, limit *= 2) {
+		if (i < HEAP_MON_BUCKETS - 1) {
+			shell_print(sh, "  <= %4zu: %u", limit, snap.hist[i]);
+		} else {
+			shell_print(sh, "   > %4zu: %u", limit / 2, snap.hist[i]);
+		}
+	}
+
+	/* Peak plus 25% headroom, rounded up to 256 bytes */
+	shell_print(sh, "  suggested size: %zu bytes",
+		    ROUND_UP(snap.peak + snap.peak / 4, 256));
+}
+
+static int cmd_heapmon_show(const struct shell *sh, size_t argc, char **argv)
+{
+	struct heap_mon *mon;
+	int ret = 0;
+
+	k_mutex_lock(&monitors_lock, K_FOREVER);
+
+	if (argc > 1) {
+		mon = find_monitor(argv[1]);
+		if (mon == NULL) {
+			shell_error(sh, "Unknown heap: %s", argv[1]);
+			ret = -ENOENT;
+		} else {
+			print_monitor(sh, mon);
+		}
+	} else {
+		SYS_SLIST_FOR_EACH_CONTAINER(&monitors, mon, node) {
+			print_monitor(sh, mon);
+		}
+	}
+
+	k_mutex_unlock(&monitors_lock);
+	return ret;
+}
+
+static int cmd_heapmon_probe(const struct shell *sh, size_t argc, char **argv)
+{
+	struct heap_mon_snapshot snap;
+	struct heap_mon *mon;
+	int ret = 0;
+
+	ARG_UNUSED(argc);
+
+	k_mutex_lock(&monitors_lock, K_FOREVER);
+
+	mon = find_monitor(argv[1]);
+	if (mon == NULL) {
+		shell_error(sh, "Unknown heap: %s", argv[1]);
+		ret = -ENOENT;
+	} else {
+		heap_mon_snapshot(mon, &snap);
+		heap_mon_probe(mon, &snap);
+		shell_print(sh, "%s: largest free block %zu of %zu free, "
+			    "fragmentation %u%%", mon->name, snap.largest_free,
+			    snap.free, snap.frag_pct);
+	}
+
+	k_mutex_unlock(&monitors_lock);
+	return ret;
+}
+
+static int cmd_heapmon_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	struct heap_mon *mon;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_mutex_lock(&monitors_lock, K_FOREVER);
+	SYS_SLIST_FOR_EACH_CONTAINER(&monitors, mon, node) {
+		heap_mon_reset(mon);
+	}
+	k_mutex_unlock(&monitors_lock);
+
+	shell_print(sh, "Heap counters reset");
+	return 0;
+}
+
+static int cmd_heapmon_log(const struct shell *sh, size_t argc, char **argv)
+{
+	int ms = atoi(argv[1]);
+
+	if (ms == 0) {
+		heap_mon_log_stop();
+		shell_print(sh, "Periodic heap log stopped");
+		return 0;
+	}
+
+	if (ms < 100) {
+		shell_error(sh, "Period must be 0 (off) or >= 100 ms");
+		return -EINVAL;
+	}
+
+	heap_mon_log_start(K_MSEC(ms));
+	shell_print(sh, "Logging heap usage every %d ms", ms);
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(heapmon_cmds,
+	SHELL_CMD_ARG(show, NULL, "Show heap statistics [name]",
+		      cmd_heapmon_show, 1, 1),
+	SHELL_CMD_ARG(probe, NULL,
+		      "Find largest free block <name> (heap must be idle)",
+		      cmd_heapmon_probe, 2, 0),
+	SHELL_CMD(reset, NULL, "Reset counters and peak", cmd_heapmon_reset),
+	SHELL_CMD_ARG(log, NULL, "Set periodic log interval <ms|0>",
+		      cmd_heapmon_log, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_REGISTER(heapmon, &heapmon_cmds, "Heap usage monitor", NULL);
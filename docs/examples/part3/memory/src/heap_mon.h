@@ -0,0 +1,81 @@
+/*
+ * Heap Monitor
+ *
+ * Instrumentation wrapper for a k_heap. Tracks live and peak usage and
+ * a histogram of request sizes, and reports them via the "heapmon"
+ * shell command and a periodic log line. The largest free block and a
+ * fragmentation ratio are available on request while the heap is idle.
+ * Requires CONFIG_SYS_HEAP_RUNTIME_STATS.
+ */
+
+#ifndef HEAP_MON_H_
+#define HEAP_MON_H_
+
+#include <zephyr/kernel.h>
+
+/* Request size buckets: <=16, <=32, ... <=2048, larger */
+#define HEAP_MON_BUCKETS 9
+
+struct heap_mon {
+	struct k_heap *heap;
+	const char *name;
+	sys_snode_t node;
+
+	atomic_t allocs;
+	atomic_t frees;
+	atomic_t failures;
+	atomic_t hist[HEAP_MON_BUCKETS];
+
+	/* Highest allocated_bytes seen after a monitored allocation */
+	atomic_t peak;
+
+	/* Size of the most recent request that could not be served */
+	atomic_t last_fail_size;
+};
+
+struct heap_mon_snapshot {
+	size_t capacity;
+	size_t live;
+	size_t peak;
+	size_t free;
+
+	/* Only filled in by heap_mon_probe(), zero otherwise */
+	size_t largest_free;
+
+	/* 0 = all free memory is one block, 100 = fully fragmented */
+	uint32_t frag_pct;
+
+	uint32_t allocs;
+	uint32_t frees;
+	uint32_t failures;
+	uint32_t last_fail_size;
+	uint32_t hist[HEAP_MON_BUCKETS];
+};
+
+/* Wrap @p heap and register it with the shell command and log output */
+void heap_mon_init(struct heap_mon *mon, struct k_heap *heap,
+		   const char *name);
+
+void *heap_mon_alloc(struct heap_mon *mon, size_t bytes,
+		     k_timeout_t timeout);
+void heap_mon_free(struct heap_mon *mon, void *mem);
+
+/* Fill @p snap with current numbers from the heap's runtime stats */
+void heap_mon_snapshot(struct heap_mon *mon, struct heap_mon_snapshot *snap);
+
+/**
+ * Add the largest free block and fragmentation to @p snap. They are
+ * found by probing the heap with trial allocations, which can make a
+ * concurrent allocation fail, so call this only while no other thread
+ * uses the heap.
+ */
+void heap_mon_probe(struct heap_mon *mon, struct heap_mon_snapshot *snap);
+
+/* Clear counters and restart peak tracking from current usage */
+void heap_mon_reset(struct heap_mon *mon);
+
+/* Log one summary line per registered heap every @p period */
+void heap_mon_log_start(k_timeout_t period);
+void heap_mon_log_stop(void);
+
+#endif /* HEAP_MON_H_ */
@@ -1,26 +1,38 @@
 /*
  * Memory Management Example
  *
- * Demonstrates k_malloc/k_free, k_heap, and memory slabs
- * for different allocation strategies.
+ * Demonstrates k_malloc/k_free, k_heap, memory slabs, and a
+ * size-class allocator built from slabs, for different allocation
+ * strategies.
  */
 
 #include <zephyr/kernel.h>
 #include <string.h>
 
+#include "sensor_data.h"
+#include "size_class.h"
+#include "heap_mon.h"
+#include "arena.h"
+#include "bench.h"
+
 /* ---- k_heap example ---- */
 
 /* Define a dedicated heap (1024 bytes) */
 K_HEAP_DEFINE(my_heap, 1024);
 
+/* Instrumentation for my_heap (see "heapmon show" in the shell) */
+static struct heap_mon my_heap_mon;
+
 static void demo_k_heap(void)
 {
 	printk("\n--- k_heap Demo ---\n");
 
+	heap_mon_init(&my_heap_mon, &my_heap, "my_heap");
+
 	/* Allocate from dedicated heap */
-	void *buf1 = k_heap_alloc(&my_heap, 64, K_NO_WAIT);
-	void *buf2 = k_heap_alloc(&my_heap, 128, K_NO_WAIT);
-	void *buf3 = k_heap_alloc(&my_heap, 256, K_NO_WAIT);
+	void *buf1 = heap_mon_alloc(&my_heap_mon, 64, K_NO_WAIT);
+	void *buf2 = heap_mon_alloc(&my_heap_mon, 128, K_NO_WAIT);
+	void *buf3 = heap_mon_alloc(&my_heap_mon, 256, K_NO_WAIT);
 
 	if (buf1) {
 		printk("Allocated 64 bytes at %p\n", buf1);
@@ -38,19 +50,28 @@ static void demo_k_heap(void)
 	}
 
 	/* Try an allocation that should fail (heap is ~1024 bytes total) */
-	void *buf4 = k_heap_alloc(&my_heap, 800, K_NO_WAIT);
+	void *buf4 = heap_mon_alloc(&my_heap_mon, 800, K_NO_WAIT);
 	if (buf4 == NULL) {
+		struct heap_mon_snapshot snap;
+
+		/* Nothing else uses my_heap yet, so probing is safe */
+		heap_mon_snapshot(&my_heap_mon, &snap);
+		heap_mon_probe(&my_heap_mon, &snap);
 		printk("Allocation of 800 bytes failed (expected - heap full)\n");
+		printk("  live %zu of %zu bytes, largest free block %zu "
+		       "(%u%% fragmented)\n",
+		       snap.live, snap.capacity, snap.largest_free,
+		       snap.frag_pct);
 	}
 
 	/* Free in different order to demonstrate fragmentation handling */
-	k_heap_free(&my_heap, buf2);
+	heap_mon_free(&my_heap_mon, buf2);
 	printk("Freed 128-byte block\n");
 
-	k_heap_free(&my_heap, buf1);
+	heap_mon_free(&my_heap_mon, buf1);
 	printk("Freed 64-byte block\n");
 
-	k_heap_free(&my_heap, buf3);
+	heap_mon_free(&my_heap_mon, buf3);
 	printk("Freed 256-byte block\n");
 
 	printk("k_heap demo complete\n");
@@ -61,14 +82,6 @@ static void demo_k_heap(void)
 /* Define a slab: 32-byte blocks, 8 blocks, 4-byte alignment */
 K_MEM_SLAB_DEFINE(my_slab, 32, 8, 4);
 
-struct sensor_data {
-	uint32_t timestamp;
-	int16_t temperature;
-	int16_t humidity;
-	uint8_t channel;
-	uint8_t reserved[3];
-};
-
 static void demo_mem_slab(void)
 {
 	printk("\n--- Memory Slab Demo ---\n");
@@ -114,6 +127,77 @@ static void demo_mem_slab(void)
 	       k_mem_slab_num_free_get(&my_slab));
 }
 
+/* ---- Size-class allocator example ---- */
+
+static void demo_size_class(void)
+{
+	printk("\n--- Size-Class Allocator Demo ---\n");
+
+	/* Small requests come from slabs, large ones from my_heap */
+	size_class_init(&my_heap_mon);
+
+	void *buf1 = size_class_alloc(64, K_NO_WAIT);
+	void *buf2 = size_class_alloc(128, K_NO_WAIT);
+	void *buf3 = size_class_alloc(256, K_NO_WAIT);
+	void *buf4 = size_class_alloc(sizeof(struct sensor_data), K_NO_WAIT);
+	void *big = size_class_alloc(512, K_NO_WAIT);
+
+	printk("64 -> %p, 128 -> %p, 256 -> %p\n", buf1, buf2, buf3);
+	printk("sensor_data (%u bytes) -> %p, 512 (heap) -> %p\n",
+	       (unsigned int)sizeof(struct sensor_data), buf4, big);
+
+	size_class_stats_print();
+
+	size_class_free(big);
+	size_class_free(buf4);
+	size_class_free(buf3);
+	size_class_free(buf2);
+	size_class_free(buf1);
+	printk("Freed all size-class blocks\n");
+}
+
+/* ---- Arena allocator example ---- */
+
+/* Scratch memory for one processing cycle */
+ARENA_DEFINE(scratch_arena, 256);
+
+static void demo_arena(void)
+{
+	printk("\n--- Arena Allocator Demo ---\n");
+
+	for (int cycle = 0; cycle < 3; cycle++) {
+		char *msg = arena_alloc(&scratch_arena, 64);
+		int *data = arena_alloc(&scratch_arena, 10 * sizeof(int));
+
+		if (msg == NULL || data == NULL) {
+			printk("Arena exhausted\n");
+			break;
+		}
+
+		/* Temporary buffer released early via a scoped mark */
+		size_t mark = arena_mark(&scratch_arena);
+		uint8_t *tmp = arena_alloc(&scratch_arena, 128);
+
+		if (tmp != NULL) {
+			memset(tmp, cycle, 128);
+		}
+		arena_release(&scratch_arena, mark);
+
+		for (int i = 0; i < 10; i++) {
+			data[i] = i * cycle;
+		}
+		snprintf(msg, 64, "cycle %d: data[9]=%d, arena used %zu bytes",
+			 cycle, data[9], scratch_arena.used);
+		printk("%s\n", msg);
+
+		/* Free everything from this cycle at once */
+		arena_reset(&scratch_arena);
+	}
+
+	printk("Arena peak: %zu of %zu bytes\n",
+	       scratch_arena.peak, scratch_arena.size);
+}
+
 /* ---- System heap (k_malloc/k_free) example ---- */
 
 static void demo_system_heap(void)
@@ -163,7 +247,21 @@ int main(void)
 	/* 3. Fixed-size memory slabs */
 	demo_mem_slab();
 
+	/* 4. Slab-backed size classes with heap fallback */
+	demo_size_class();
+
+	/* 5. Per-cycle arena with one reset */
+	demo_arena();
+
+	/* Benchmarks */
+	bench_size_class();
+	bench_slab_cache();
+	bench_arena();
+
 	printk("\nAll memory demos complete.\n");
 
+	/* Keep reporting heap usage; inspect details with "heapmon show" */
+	heap_mon_log_start(K_SECONDS(10));
+
 	return 0;
 }
@@ -0,0 +1,18 @@
+/*
+ * Sensor sample stored in memory slab blocks
+ */
+
+#ifndef SENSOR_DATA_H_
+#define SENSOR_DATA_H_
+
+#include <zephyr/kernel.h>
+
+struct sensor_data {
+	uint32_t timestamp;
+	int16_t temperature;
+	int16_t humidity;
+	uint8_t channel;
+	uint8_t reserved[3];
+};
+
+#endif /* SENSOR_DATA_H_ */
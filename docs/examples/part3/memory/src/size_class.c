@@ -0,0 +1,246 @@
+/*
+ * Size-Class Allocator
+ *
+ * Each class is a k_mem_slab, so a small allocation is an O(1) pop
+ * from a free list under that slab's own lock. Only requests that do
+ * not fit a class fall through to the (first-fit) k_heap, through its
+ * heap monitor so those allocations show up in the heap report.
+ */
+
+#include "size_class.h"
+
+/* Slab pools: block size, number of blocks, alignment */
+K_MEM_SLAB_DEFINE_STATIC(class_32_slab, 32, 16, 8);
+K_MEM_SLAB_DEFINE_STATIC(class_64_slab, 64, 16, 8);
+K_MEM_SLAB_DEFINE_STATIC(class_128_slab, 128, 8, 8);
+K_MEM_SLAB_DEFINE_STATIC(class_256_slab, 256, 8, 8);
+
+/* Requested size of every block currently in use, per class */
+static uint16_t class_32_req[16];
+static uint16_t class_64_req[16];
+static uint16_t class_128_req[8];
+static uint16_t class_256_req[8];
+
+struct size_class {
+	struct k_mem_slab *slab;
+	size_t block_size;
+	uint32_t num_blocks;
+	uint16_t *requested;
+};
+
+static struct size_class classes[SIZE_CLASS_COUNT] = {
+	{ &class_32_slab, 32, ARRAY_SIZE(class_32_req), class_32_req },
+	{ &class_64_slab, 64, ARRAY_SIZE(class_64_req), class_64_req },
+	{ &class_128_slab, 128, ARRAY_SIZE(class_128_req), class_128_req },
+	{ &class_256_slab, 256, ARRAY_SIZE(class_256_req), class_256_req },
+};
+
+static struct heap_mon *fallback_heap;
+
+/* Counters are atomics so the fast path never takes a shared lock */
+static atomic_t class_allocs[SIZE_CLASS_COUNT];
+static atomic_t heap_allocs;
+static atomic_t spills;
+static atomic_t failures;
+static atomic_t frees;
+static atomic_t alloc_cycles_total;
+static atomic_t alloc_cycles_max;
+static atomic_t free_cycles_total;
+static atomic_t free_cycles_max;
+static atomic_t live_requested;
+static atomic_t live_granted;
+
+static void update_max(atomic_t *max, uint32_t value)
+{
+	atomic_val_t old = atomic_get(max);
+
+	while ((uint32_t)old < value && !atomic_cas(max, old, value)) {
+		old = atomic_get(max);
+	}
+}
+
+/* Index of the smallest class that fits, or -1 if none does */
+static int class_index(size_t size)
+{
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		if (size <= classes[i].block_size) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/* Index of the class that owns @p ptr, or -1 for heap memory */
+static int owner_index(const void *ptr, uint32_t *block)
+{
+	const char *p = ptr;
+
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		const char *start = classes[i].slab->buffer;
+		size_t span = classes[i].block_size * classes[i].num_blocks;
+
+		if (p >= start && p < start + span) {
+			*block = (p - start) / classes[i].block_size;
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+void size_class_init(struct heap_mon *fallback)
+{
+	fallback_heap = fallback;
+	size_class_stats_reset();
+}
+
+size_t size_class_block_size(int index)
+{
+	return classes[index].block_size;
+}
+
+void *size_class_alloc(size_t size, k_timeout_t timeout)
+{
+	uint32_t start = k_cycle_get_32();
+	void *ptr = NULL;
+	int first = class_index(size);
+
+	if (first >= 0) {
+		/* Try the best-fitting class, then spill to larger ones */
+		for (int i = first; i < SIZE_CLASS_COUNT; i++) {
+			if (k_mem_slab_alloc(classes[i].slab, &ptr, K_NO_WAIT) != 0) {
+				continue;
+			}
+
+			uint32_t block;
+
+			owner_index(ptr, &block);
+			classes[i].requested[block] = size;
+			atomic_inc(&class_allocs[i]);
+			atomic_add(&live_requested, size);
+			atomic_add(&live_granted, classes[i].block_size);
+			if (i != first) {
+				atomic_inc(&spills);
+			}
+			break;
+		}
+	}
+
+	if (ptr == NULL && fallback_heap != NULL) {
+		ptr = heap_mon_alloc(fallback_heap, size, timeout);
+		if (ptr != NULL) {
+			atomic_inc(&heap_allocs);
+		}
+	}
+
+	if (ptr == NULL) {
+		atomic_inc(&failures);
+	}
+
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	atomic_add(&alloc_cycles_total, cycles);
+	update_max(&alloc_cycles_max, cycles);
+
+	return ptr;
+}
+
+void size_class_free(void *ptr)
+{
+	if (ptr == NULL) {
+		return;
+	}
+
+	uint32_t start = k_cycle_get_32();
+	uint32_t block;
+	int i = owner_index(ptr, &block);
+
+	if (i >= 0) {
+		atomic_sub(&live_requested, classes[i].requested[block]);
+		atomic_sub(&live_granted, classes[i].block_size);
+		k_mem_slab_free(classes[i].slab, ptr);
+	} else {
+		heap_mon_free(fallback_heap, ptr);
+	}
+
+	atomic_inc(&frees);
+
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	atomic_add(&free_cycles_total, cycles);
+	update_max(&free_cycles_max, cycles);
+}
+
+void size_class_stats_get(struct size_class_stats *stats)
+{
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		stats->class_allocs[i] = atomic_get(&class_allocs[i]);
+	}
+
+	stats->heap_allocs = atomic_get(&heap_allocs);
+	stats->spills = atomic_get(&spills);
+	stats->failures = atomic_get(&failures);
+	stats->frees = atomic_get(&frees);
+	stats->alloc_cycles_total = atomic_get(&alloc_cycles_total);
+	stats->alloc_cycles_max = atomic_get(&alloc_cycles_max);
+	stats->free_cycles_total = atomic_get(&free_cycles_total);
+	stats->free_cycles_max = atomic_get(&free_cycles_max);
+	stats->live_requested = atomic_get(&live_requested);
+	stats->live_granted = atomic_get(&live_granted);
+}
+
+void size_class_stats_reset(void)
+{
+	/* Live byte counts describe current state and are not reset */
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		atomic_clear(&class_allocs[i]);
+	}
+
+	atomic_clear(&heap_allocs);
+	atomic_clear(&spills);
+	atomic_clear(&failures);
+	atomic_clear(&frees);
+	atomic_clear(&alloc_cycles_total);
+	atomic_clear(&alloc_cycles_max);
+	atomic_clear(&free_cycles_total);
+	atomic_clear(&free_cycles_max);
+}
+
+void size_class_stats_print(void)
+{
+	struct size_class_stats s;
+	uint32_t allocs = 0;
+
+	size_class_stats_get(&s);
+
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		printk("  class %3u: %u allocs, %u/%u blocks in use\n",
+		       (unsigned int)classes[i].block_size, s.class_allocs[i],
+		       k_mem_slab_num_used_get(classes[i].slab),
+		       classes[i].num_blocks);
+		allocs += s.class_allocs[i];
+	}
+	allocs += s.heap_allocs + s.failures;
+
+	printk("  heap     : %u allocs\n", s.heap_allocs);
+	printk("  spills=%u failures=%u frees=%u\n",
+	       s.spills, s.failures, s.frees);
+
+	if (allocs > 0) {
+		printk("  alloc: avg %u cycles, max %u cycles\n",
+		       s.alloc_cycles_total / allocs, s.alloc_cycles_max);
+	}
+	if (s.frees > 0) {
+		printk("  free : avg %u cycles, max %u cycles\n",
+		       s.free_cycles_total / s.frees, s.free_cycles_max);
+	}
+
+	/* Internal fragmentation: slab bytes handed out but not requested */
+	uint32_t wasted = s.live_granted - s.live_requested;
+
+	printk("  live: %u bytes requested in %u bytes of blocks "
+	       "(%u%% internal fragmentation)\n",
+	       s.live_requested, s.live_granted,
+	       s.live_granted ? (wasted * 100) / s.live_granted : 0);
+}
@@ -0,0 +1,73 @@
+/*
+ * Size-Class Allocator
+ *
+ * Front-end that serves small requests from fixed-size memory slabs
+ * (32/64/128/256 bytes) and sends everything else to a monitored
+ * k_heap.
+ */
+
+#ifndef SIZE_CLASS_H_
+#define SIZE_CLASS_H_
+
+#include <zephyr/kernel.h>
+
+#include "heap_mon.h"
+
+/* Number of slab size classes (32, 64, 128, 256 bytes) */
+#define SIZE_CLASS_COUNT 4
+
+/* Largest request served from a slab; bigger ones go to the heap */
+#define SIZE_CLASS_MAX_BLOCK 256
+
+struct size_class_stats {
+	/* Successful allocations per slab class, and from the heap */
+	uint32_t class_allocs[SIZE_CLASS_COUNT];
+	uint32_t heap_allocs;
+
+	/* Requests that found their class empty and used a larger one */
+	uint32_t spills;
+
+	/* Requests that could not be served at all */
+	uint32_t failures;
+	uint32_t frees;
+
+	/* Cycles spent in size_class_alloc()/size_class_free() */
+	uint32_t alloc_cycles_total;
+	uint32_t alloc_cycles_max;
+	uint32_t free_cycles_total;
+	uint32_t free_cycles_max;
+
+	/*
+	 * Bytes requested by callers that currently hold slab blocks,
+	 * versus the size of those blocks. The difference is internal
+	 * fragmentation; heap allocations are not counted here.
+	 */
+	uint32_t live_requested;
+	uint32_t live_granted;
+};
+
+/**
+ * Bind the allocator to the monitored heap used for requests larger
+ * than SIZE_CLASS_MAX_BLOCK (or when every slab class is exhausted).
+ */
+void size_class_init(struct heap_mon *fallback);
+
+/**
+ * Allocate @p size bytes. Slab classes are tried without waiting;
+ * only the heap fallback honours @p timeout.
+ *
+ * @return Pointer to memory, or NULL on failure.
+ */
+void *size_class_alloc(size_t size, k_timeout_t timeout);
+
+/* Return memory obtained from size_class_alloc(). NULL is ignored. */
+void size_class_free(void *ptr);
+
+/* Block size of the class @p index (0..SIZE_CLASS_COUNT-1) */
+size_t size_class_block_size(int index);
+
+void size_class_stats_get(struct size_class_stats *stats);
+void size_class_stats_reset(void);
+void size_class_stats_print(void);
+
+#endif /* SIZE_CLASS_H_ */
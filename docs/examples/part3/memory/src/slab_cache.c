@@ -0,0 +1,140 @@
+/*
+ * Per-Thread Slab Cache
+ *
+ * Free blocks in the depot are chained through their first word, so
+ * the depot needs no storage of its own.
+ */
+
+#include "slab_cache.h"
+
+void slab_depot_init(struct slab_depot *depot, struct k_mem_slab *slab)
+{
+	*depot = (struct slab_depot){ .slab = slab };
+}
+
+void slab_depot_flush(struct slab_depot *depot)
+{
+	k_spinlock_key_t key = k_spin_lock(&depot->lock);
+	void *list = depot->free_list;
+
+	depot->free_list = NULL;
+	depot->free_count = 0;
+	k_spin_unlock(&depot->lock, key);
+
+	while (list != NULL) {
+		void *next = *(void **)list;
+
+		k_mem_slab_free(depot->slab, list);
+		list = next;
+	}
+}
+
+void slab_cache_init(struct slab_cache *cache, struct slab_depot *depot)
+{
+	*cache = (struct slab_cache){ .depot = depot };
+}
+
+/* Move up to SLAB_CACHE_BATCH blocks from the depot into the cache */
+static void refill_from_depot(struct slab_cache *cache)
+{
+	struct slab_depot *depot = cache->depot;
+	k_spinlock_key_t key = k_spin_lock(&depot->lock);
+
+	while (depot->free_list != NULL && cache->count < SLAB_CACHE_BATCH) {
+		void *block = depot->free_list;
+
+		depot->free_list = *(void **)block;
+		depot->free_count--;
+		cache->blocks[cache->count++] = block;
+	}
+
+	k_spin_unlock(&depot->lock, key);
+}
+
+/* Move up to SLAB_CACHE_BATCH blocks from the slab into the cache */
+static int refill_from_slab(struct slab_cache *cache, k_timeout_t timeout)
+{
+	int ret = k_mem_slab_alloc(cache->depot->slab,
+				   &cache->blocks[cache->count], timeout);
+
+	if (ret != 0) {
+		return ret;
+	}
+	cache->count++;
+
+	/* Top up opportunistically; never wait for the extra blocks */
+	while (cache->count < SLAB_CACHE_BATCH &&
+	       k_mem_slab_alloc(cache->depot->slab,
+				&cache->blocks[cache->count], K_NO_WAIT) == 0) {
+		cache->count++;
+	}
+
+	return 0;
+}
+
+int slab_cache_alloc(struct slab_cache *cache, void **mem,
+		     k_timeout_t timeout)
+{
+	if (cache->count == 0) {
+		cache->refills++;
+		refill_from_depot(cache);
+
+		if (cache->count == 0) {
+			int ret = refill_from_slab(cache, timeout);
+
+			if (ret != 0) {
+				return ret;
+			}
+		}
+	} else {
+		cache->hits++;
+	}
+
+	*mem = cache->blocks[--cache->count];
+	return 0;
+}
+
+/* Push the @p n most recently cached blocks to the depot */
+static void drain_to_depot(struct slab_cache *cache, uint32_t n)
+{
+	struct slab_depot *depot = cache->depot;
+	void *head = NULL;
+	void *tail = NULL;
+
+	/* Chain the blocks outside the lock, then splice in one step */
+	for (uint32_t i = 0; i < n; i++) {
+		void *block = cache->blocks[--cache->count];
+
+		*(void **)block = head;
+		head = block;
+		if (tail == NULL) {
+			tail = block;
+		}
+	}
+
+	if (head == NULL) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&depot->lock);
+
+	*(void **)tail = depot->free_list;
+	depot->free_list = head;
+	depot->free_count += n;
+	k_spin_unlock(&depot->lock, key);
+}
+
+void slab_cache_free(struct slab_cache *cache, void *mem)
+{
+	if (cache->count == SLAB_CACHE_SIZE) {
+		cache->drains++;
+		drain_to_depot(cache, SLAB_CACHE_BATCH);
+	}
+
+	cache->blocks[cache->count++] = mem;
+}
+
+void slab_cache_flush(struct slab_cache *cache)
+{
+	drain_to_depot(cache, cache->count);
+}
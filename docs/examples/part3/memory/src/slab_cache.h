@@ -0,0 +1,65 @@
+/*
+ * Per-Thread Slab Cache
+ *
+ * A magazine layer over k_mem_slab. Each thread owns a slab_cache
+ * holding a few free blocks, so most allocations and frees touch no
+ * lock at all. When a cache runs empty or full it moves a batch of
+ * blocks to or from a shared depot under a single lock acquisition.
+ */
+
+#ifndef SLAB_CACHE_H_
+#define SLAB_CACHE_H_
+
+#include <zephyr/kernel.h>
+
+/* Blocks a thread may hold in its local cache */
+#define SLAB_CACHE_SIZE 8
+
+/* Blocks moved between a cache and the depot per refill or drain */
+#define SLAB_CACHE_BATCH 4
+
+/* Shared pool of free blocks sitting between the caches and the slab */
+struct slab_depot {
+	struct k_mem_slab *slab;
+	struct k_spinlock lock;
+	void *free_list;
+	uint32_t free_count;
+};
+
+/* Thread-local cache; must only be used by the thread that owns it */
+struct slab_cache {
+	struct slab_depot *depot;
+	uint32_t count;
+	void *blocks[SLAB_CACHE_SIZE];
+
+	/* Allocations served locally, and batch transfers to/from depot */
+	uint32_t hits;
+	uint32_t refills;
+	uint32_t drains;
+};
+
+/* Blocks of @p slab must be at least pointer-sized */
+void slab_depot_init(struct slab_depot *depot, struct k_mem_slab *slab);
+
+/* Give every block parked in the depot back to the slab */
+void slab_depot_flush(struct slab_depot *depot);
+
+void slab_cache_init(struct slab_cache *cache, struct slab_depot *depot);
+
+/**
+ * Take a block from the cache, refilling it from the depot (or the
+ * slab) when empty. Only a refill from the slab can wait for
+ * @p timeout.
+ *
+ * @return 0 on success, or the k_mem_slab_alloc() error.
+ */
+int slab_cache_alloc(struct slab_cache *cache, void **mem,
+		     k_timeout_t timeout);
+
+/* Put a block back into the cache, draining a batch when full */
+void slab_cache_free(struct slab_cache *cache, void *mem);
+
+/* Return all locally cached blocks to the depot (e.g. on thread exit) */
+void slab_cache_flush(struct slab_cache *cache);
+
+#endif /* SLAB_CACHE_H_ */
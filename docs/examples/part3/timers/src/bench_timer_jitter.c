@@ -0,0 +1,216 @@
+/*
+ * Timer Jitter and Drift Benchmark
+ *
+ * Runs a periodic k_timer and timestamps every expiry with a 64-bit
+ * cycle count, both in the expiry function (ISR) and in a thread
+ * woken by k_timer_status_sync(), which is where a control loop would
+ * run. Jitter is each interval's deviation from the period; drift is
+ * how far the last expiry is from where the first expiry plus whole
+ * periods puts it. Each scenario adds background load:
+ *
+ *   cpu  - a higher-priority thread busy 3 ms out of every 10, plus a
+ *          low-priority thread that never sleeps
+ *   irq  - a k_timer firing every millisecond (or every tick, if that
+ *          is longer) that busy-waits 200 us in its expiry function
+ *
+ * On native_sim busy waits and timers run on simulated time, so only
+ * tick rounding shows; qemu and real boards show the load effects.
+ * Stamps come from cycle_stamp_get(), which also works on boards
+ * without a 64-bit cycle counter (qemu_cortex_m3's SysTick, for one);
+ * the sample timer calls it every JITTER_PERIOD_MS, well inside a wrap.
+ */
+
+#include <zephyr/kernel.h>
+#include <stdlib.h>
+
+#include "cycle_stamp.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define JITTER_PERIOD_MS 100
+#define JITTER_SAMPLES 100	/* intervals per scenario */
+#define SAMPLER_PRIO 5
+#define BURST_PRIO 4		/* preempts the sampler */
+#define HOG_PRIO 10
+#define BURST_BUSY_MS 3
+#define BURST_SLEEP_MS 7
+#define IRQ_BUSY_US 200
+
+struct scenario {
+	const char *name;
+	bool cpu;
+	bool irq;
+};
+
+static const struct scenario scenarios[] = {
+	{ "idle", false, false },
+	{ "cpu", true, false },
+	{ "irq", false, true },
+	{ "cpu+irq", true, true },
+};
+
+K_THREAD_STACK_DEFINE(sampler_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(burst_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(hog_stack, STACK_SIZE);
+static struct k_thread sampler_thread;
+static struct k_thread burst_thread;
+static struct k_thread hog_thread;
+
+static uint64_t isr_stamps[JITTER_SAMPLES + 1];
+static uint32_t isr_count;
+
+/* Thread wakeups and the expiry count each one covered */
+static uint64_t thread_stamps[JITTER_SAMPLES + 1];
+static uint32_t thread_expiries[JITTER_SAMPLES + 1];
+
+static atomic_t load_running;
+
+/* |jitter| in us, sorted for percentiles */
+static uint32_t sorted[JITTER_SAMPLES];
+
+static void sample_expiry(struct k_timer *timer)
+{
+	if (isr_count < ARRAY_SIZE(isr_stamps)) {
+		isr_stamps[isr_count++] = cycle_stamp_get();
+	}
+}
+
+static void irq_load_expiry(struct k_timer *timer)
+{
+	k_busy_wait(IRQ_BUSY_US);
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_expiry, NULL);
+static K_TIMER_DEFINE(irq_load_timer, irq_load_expiry, NULL);
+
+static void burst_entry(void *p1, void *p2, void *p3)
+{
+	while (atomic_get(&load_running)) {
+		k_busy_wait(BURST_BUSY_MS * USEC_PER_MSEC);
+		k_msleep(BURST_SLEEP_MS);
+	}
+}
+
+static void hog_entry(void *p1, void *p2, void *p3)
+{
+	while (atomic_get(&load_running)) {
+		k_busy_wait(1000);
+	}
+}
+
+static void sampler_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t expiries = 0;
+
+	k_timer_start(&sample_timer, K_MSEC(JITTER_PERIOD_MS),
+		      K_MSEC(JITTER_PERIOD_MS));
+
+	for (size_t i = 0; i < ARRAY_SIZE(thread_stamps); i++) {
+		expiries += k_timer_status_sync(&sample_timer);
+		thread_stamps[i] = cycle_stamp_get();
+		thread_expiries[i] = expiries;
+	}
+
+	k_timer_stop(&sample_timer);
+}
+
+static int32_t cycles_to_us(int64_t cycles)
+{
+	return (int32_t)(cycles * USEC_PER_SEC /
+			 (int64_t)sys_clock_hw_cycles_per_sec());
+}
+
+static void insert_sorted(size_t n, uint32_t value)
+{
+	size_t j = n;
+
+	while (j > 0 && sorted[j - 1] > value) {
+		sorted[j] = sorted[j - 1];
+		j--;
+	}
+	sorted[j] = value;
+}
+
+static uint32_t percentile(size_t n, uint32_t pct_x10)
+{
+	size_t rank = ((uint64_t)n * pct_x10 + 999) / 1000;
+
+	return n ? sorted[MAX(rank, 1) - 1] : 0;
+}
+
+/*
+ * Print jitter percentiles and drift for @p n + 1 stamps; @p expiries
+ * gives the periods each stamp is past the first (NULL: one per stamp).
+ */
+static void report(const char *scenario, const char *where,
+		   const uint64_t *stamps, const uint32_t *expiries, size_t n)
+{
+	int64_t period = (int64_t)JITTER_PERIOD_MS *
+		sys_clock_hw_cycles_per_sec() / MSEC_PER_SEC;
+
+	for (size_t i = 1; i <= n; i++) {
+		uint32_t periods = expiries ? expiries[i] - expiries[i - 1] : 1;
+		int64_t dev = (int64_t)(stamps[i] - stamps[i - 1]) -
+			period * periods;
+
+		insert_sorted(i - 1, (uint32_t)abs(cycles_to_us(dev)));
+	}
+
+	uint32_t total = expiries ? expiries[n] - expiries[0] : n;
+	int32_t drift = cycles_to_us((int64_t)(stamps[n] - stamps[0]) -
+				     period * total);
+	int32_t ppm = total ? (int32_t)((int64_t)drift * 1000 /
+					 ((int64_t)total * JITTER_PERIOD_MS)) : 0;
+
+	printk("%-8s %-6s %8u %8u %8u %10d %6d\n", scenario, where,
+	       percentile(n, 500), percentile(n, 990), percentile(n, 1000),
+	       drift, ppm);
+}
+
+static void run(const struct scenario *sc)
+{
+	isr_count = 0;
+	atomic_set(&load_running, 1);
+
+	if (sc->cpu) {
+		k_thread_create(&burst_thread, burst_stack, STACK_SIZE,
+				burst_entry, NULL, NULL, NULL, BURST_PRIO, 0,
+				K_NO_WAIT);
+		k_thread_create(&hog_thread, hog_stack, STACK_SIZE,
+				hog_entry, NULL, NULL, NULL, HOG_PRIO, 0,
+				K_NO_WAIT);
+	}
+	if (sc->irq) {
+		k_timer_start(&irq_load_timer, K_MSEC(1), K_MSEC(1));
+	}
+
+	k_thread_create(&sampler_thread, sampler_stack, STACK_SIZE,
+			sampler_entry, NULL, NULL, NULL, SAMPLER_PRIO, 0,
+			K_NO_WAIT);
+	k_thread_join(&sampler_thread, K_FOREVER);
+
+	k_timer_stop(&irq_load_timer);
+	atomic_set(&load_running, 0);
+	if (sc->cpu) {
+		k_thread_join(&burst_thread, K_FOREVER);
+		k_thread_join(&hog_thread, K_FOREVER);
+	}
+
+	report(sc->name, "isr", isr_stamps, NULL,
+	       MIN(isr_count, ARRAY_SIZE(isr_stamps)) - 1);
+	report(sc->name, "thread", thread_stamps, thread_expiries,
+	       ARRAY_SIZE(thread_stamps) - 1);
+}
+
+void bench_timer_jitter(void)
+{
+	printk("\n--- Benchmark: periodic timer jitter and drift ---\n");
+	printk("%d ms period, %d intervals per scenario, jitter in us\n",
+	       JITTER_PERIOD_MS, JITTER_SAMPLES);
+	printk("%-8s %-6s %8s %8s %8s %10s %6s\n", "load", "where", "p50",
+	       "p99", "max", "drift us", "ppm");
+
+	for (size_t i = 0; i < ARRAY_SIZE(scenarios); i++) {
+		run(&scenarios[i]);
+	}
+}
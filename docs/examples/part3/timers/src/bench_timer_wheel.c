@@ -0,0 +1,125 @@
+/*
+ * Timer Wheel Benchmark
+ *
+ * Starts N timers with delays spread pseudo-randomly over a minute,
+ * then stops them again, once as k_timers and once as wheel timers.
+ * Nothing expires during the measurement. k_timer_start() inserts into
+ * the kernel's sorted timeout list, so its cost grows with the number
+ * of timers already running; the wheel's should stay flat.
+ *
+ * The timer array is shared by both runs. 10000 k_timers need about
+ * half a megabyte of RAM, so boards other than native_sim stop at 100.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "timer_wheel.h"
+#include "bench.h"
+
+#ifdef CONFIG_ARCH_POSIX
+#define BENCH_MAX_TIMERS 10000
+#else
+#define BENCH_MAX_TIMERS 100
+#endif
+
+#define MIN_DELAY_MS 1000
+#define DELAY_SPREAD_MS 60000
+
+static const uint32_t timer_counts[] = { 10, 100, 1000, 10000 };
+
+static union {
+	struct k_timer k[BENCH_MAX_TIMERS];
+	struct tw_timer w[BENCH_MAX_TIMERS];
+} timers;
+
+static struct timer_wheel bench_wheel;
+
+static void k_expiry(struct k_timer *timer)
+{
+}
+
+static void tw_expiry(struct tw_timer *timer)
+{
+}
+
+/* Same delay sequence for both runs */
+static uint32_t next_delay(uint32_t *state)
+{
+	*state = *state * 1664525u + 1013904223u;
+	return MIN_DELAY_MS + (*state >> 8) % DELAY_SPREAD_MS;
+}
+
+static void run_k_timer(uint32_t n, uint32_t *start_cyc, uint32_t *stop_cyc)
+{
+	uint32_t seed = 1;
+	uint32_t t0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		k_timer_init(&timers.k[i], k_expiry, NULL);
+	}
+
+	t0 = k_cycle_get_32();
+	for (uint32_t i = 0; i < n; i++) {
+		k_timer_start(&timers.k[i], K_MSEC(next_delay(&seed)),
+			      K_NO_WAIT);
+	}
+	*start_cyc = k_cycle_get_32() - t0;
+
+	t0 = k_cycle_get_32();
+	for (uint32_t i = 0; i < n; i++) {
+		k_timer_stop(&timers.k[i]);
+	}
+	*stop_cyc = k_cycle_get_32() - t0;
+}
+
+static void run_wheel(uint32_t n, uint32_t *start_cyc, uint32_t *stop_cyc)
+{
+	uint32_t seed = 1;
+	uint32_t t0;
+
+	timer_wheel_init(&bench_wheel, 1);
+	for (uint32_t i = 0; i < n; i++) {
+		tw_timer_init(&timers.w[i], tw_expiry, NULL);
+	}
+
+	t0 = k_cycle_get_32();
+	for (uint32_t i = 0; i < n; i++) {
+		tw_timer_start(&bench_wheel, &timers.w[i], next_delay(&seed), 0);
+	}
+	*start_cyc = k_cycle_get_32() - t0;
+
+	t0 = k_cycle_get_32();
+	for (uint32_t i = 0; i < n; i++) {
+		tw_timer_stop(&bench_wheel, &timers.w[i]);
+	}
+	*stop_cyc = k_cycle_get_32() - t0;
+}
+
+void bench_timer_wheel(void)
+{
+	uint32_t start_cyc, stop_cyc;
+
+	printk("\n--- Benchmark: timer start/stop cost ---\n");
+	printk("Delays %d..%d ms, cycles per call\n", MIN_DELAY_MS,
+	       MIN_DELAY_MS + DELAY_SPREAD_MS - 1);
+	printk("%-8s %-8s %10s %10s\n", "timers", "scheme", "start",
+	       "stop");
+
+	for (size_t i = 0; i < ARRAY_SIZE(timer_counts); i++) {
+		uint32_t n = timer_counts[i];
+
+		if (n > BENCH_MAX_TIMERS) {
+			printk("%-8u (skipped, BENCH_MAX_TIMERS is %d)\n", n,
+			       BENCH_MAX_TIMERS);
+			continue;
+		}
+
+		run_k_timer(n, &start_cyc, &stop_cyc);
+		printk("%-8u %-8s %10u %10u\n", n, "k_timer", start_cyc / n,
+		       stop_cyc / n);
+
+		run_wheel(n, &start_cyc, &stop_cyc);
+		printk("%-8u %-8s %10u %10u\n", n, "wheel", start_cyc / n,
+		       stop_cyc / n);
+	}
+}
@@ -6,6 +6,12 @@
 
 #include <zephyr/kernel.h>
 
+#include "timer_wheel.h"
+#include "bench.h"
+
+#define NUM_SENSORS 8
+#define WHEEL_TICK_MS 10
+
 /* Timer expiry handlers */
 void periodic_timer_handler(struct k_timer *timer)
 {
@@ -27,6 +33,18 @@ void timer_stop_handler(struct k_timer *timer)
 K_TIMER_DEFINE(periodic_timer, periodic_timer_handler, timer_stop_handler);
 K_TIMER_DEFINE(oneshot_timer, oneshot_timer_handler, NULL);
 
+/* One periodic wheel timer per sensor, all on one k_timer tick */
+static struct timer_wheel sensor_wheel;
+static struct tw_timer sensor_timers[NUM_SENSORS];
+static uint32_t sensor_polls[NUM_SENSORS];
+
+void sensor_poll_handler(struct tw_timer *timer)
+{
+	uint32_t *polls = timer->user_data;
+
+	(*polls)++;
+}
+
 int main(void)
 {
 	printk("Timers Example\n");
@@ -58,6 +76,29 @@ int main(void)
 	k_timer_status_sync(&oneshot_timer);
 	printk("Synchronous wait complete\n");
 
+	/* Sensors polled every 100, 200, ... 800 ms for two seconds */
+	printk("Starting %d sensor timers on a timer wheel\n", NUM_SENSORS);
+	timer_wheel_init(&sensor_wheel, WHEEL_TICK_MS);
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		uint32_t period = 100 * (i + 1);
+
+		tw_timer_init(&sensor_timers[i], sensor_poll_handler,
+			      &sensor_polls[i]);
+		tw_timer_start(&sensor_wheel, &sensor_timers[i], period,
+			       period);
+	}
+	timer_wheel_start(&sensor_wheel);
+	k_sleep(K_SECONDS(2));
+	timer_wheel_stop(&sensor_wheel);
+
+	for (size_t i = 0; i < NUM_SENSORS; i++) {
+		printk("Sensor %zu (%zu ms): %u polls\n", i, 100 * (i + 1),
+		       sensor_polls[i]);
+	}
+
+	bench_timer_wheel();
+	bench_timer_jitter();
+
 	printk("Example complete\n");
 
 	return 0;
@@ -0,0 +1,156 @@
+/*
+ * Hierarchical Timer Wheel
+ *
+ * A timer due in d ticks sits on the lowest level whose span covers d:
+ * level L holds timers due within 64^(L+1) ticks, in the slot picked by
+ * bits 6L..6L+5 of the expiry tick. Each tick the level 0 slot for the
+ * new time is emptied and its timers expire. Whenever the lower bits of
+ * the time wrap to zero, the matching slot one level up is "cascaded":
+ * its timers, now due within that level's span, are re-inserted lower.
+ * Every timer is thus touched at most once per level.
+ */
+
+#include "timer_wheel.h"
+
+#define SLOT_MASK (TW_SLOTS - 1)
+#define MAX_DELTA (BIT(TW_LEVEL_BITS * TW_LEVELS) - 1)
+
+static void insert(struct timer_wheel *tw, struct tw_timer *timer)
+{
+	uint32_t delta = timer->expires - tw->now;
+
+	if (delta > MAX_DELTA) {
+		delta = MAX_DELTA;
+		timer->expires = tw->now + delta;
+	}
+
+	size_t level = 0;
+
+	while (level < TW_LEVELS - 1 &&
+	       delta >= BIT(TW_LEVEL_BITS * (level + 1))) {
+		level++;
+	}
+
+	size_t slot = (timer->expires >> (TW_LEVEL_BITS * level)) & SLOT_MASK;
+
+	sys_dlist_append(&tw->slots[level][slot], &timer->node);
+}
+
+static void cascade(struct timer_wheel *tw, size_t level)
+{
+	size_t slot = (tw->now >> (TW_LEVEL_BITS * level)) & SLOT_MASK;
+	sys_dlist_t *list = &tw->slots[level][slot];
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		insert(tw, CONTAINER_OF(node, struct tw_timer, node));
+		tw->cascaded++;
+	}
+}
+
+static void advance(struct timer_wheel *tw)
+{
+	k_spinlock_key_t key = k_spin_lock(&tw->lock);
+
+	tw->now++;
+
+	for (size_t level = 1; level < TW_LEVELS; level++) {
+		if ((tw->now & (BIT(TW_LEVEL_BITS * level) - 1)) != 0) {
+			break;
+		}
+		cascade(tw, level);
+	}
+
+	sys_dlist_t *list = &tw->slots[0][tw->now & SLOT_MASK];
+	sys_dnode_t *node;
+
+	/* Unlock around each expiry so it may start and stop timers */
+	while ((node = sys_dlist_get(list)) != NULL) {
+		struct tw_timer *timer = CONTAINER_OF(node, struct tw_timer, node);
+
+		if (timer->period != 0) {
+			timer->expires += timer->period;
+			insert(tw, timer);
+		}
+		tw->expired++;
+
+		k_spin_unlock(&tw->lock, key);
+		timer->expiry(timer);
+		key = k_spin_lock(&tw->lock);
+	}
+
+	k_spin_unlock(&tw->lock, key);
+}
+
+static void tick_expiry(struct k_timer *tick_timer)
+{
+	advance(CONTAINER_OF(tick_timer, struct timer_wheel, tick_timer));
+}
+
+void timer_wheel_init(struct timer_wheel *tw, uint32_t tick_ms)
+{
+	k_timer_init(&tw->tick_timer, tick_expiry, NULL);
+	tw->tick_ms = tick_ms;
+	tw->now = 0;
+	tw->expired = 0;
+	tw->cascaded = 0;
+
+	for (size_t level = 0; level < TW_LEVELS; level++) {
+		for (size_t slot = 0; slot < TW_SLOTS; slot++) {
+			sys_dlist_init(&tw->slots[level][slot]);
+		}
+	}
+}
+
+void timer_wheel_start(struct timer_wheel *tw)
+{
+	k_timer_start(&tw->tick_timer, K_MSEC(tw->tick_ms),
+		      K_MSEC(tw->tick_ms));
+}
+
+void timer_wheel_stop(struct timer_wheel *tw)
+{
+	k_timer_stop(&tw->tick_timer);
+}
+
+void tw_timer_init(struct tw_timer *timer, tw_expiry_t expiry,
+		   void *user_data)
+{
+	sys_dnode_init(&timer->node);
+	timer->expiry = expiry;
+	timer->user_data = user_data;
+	timer->period = 0;
+}
+
+static uint32_t ms_to_ticks(const struct timer_wheel *tw, uint32_t ms)
+{
+	return DIV_ROUND_UP(ms, tw->tick_ms);
+}
+
+void tw_timer_start(struct timer_wheel *tw, struct tw_timer *timer,
+		    uint32_t delay_ms, uint32_t period_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&tw->lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	/* At least one tick, so it never lands in the slot just emptied */
+	timer->expires = tw->now + MAX(ms_to_ticks(tw, delay_ms), 1);
+	timer->period = ms_to_ticks(tw, period_ms);
+	insert(tw, timer);
+
+	k_spin_unlock(&tw->lock, key);
+}
+
+void tw_timer_stop(struct timer_wheel *tw, struct tw_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&tw->lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+	}
+
+	k_spin_unlock(&tw->lock, key);
+}
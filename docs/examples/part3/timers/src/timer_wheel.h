@@ -0,0 +1,72 @@
+/*
+ * Hierarchical Timer Wheel
+ *
+ * Application-level software timers for large numbers of periodic and
+ * one-shot timeouts, all driven by a single k_timer tick. Starting and
+ * stopping a timer is O(1) whatever the number of running timers,
+ * where k_timer_start() walks the kernel's sorted timeout list.
+ *
+ * Four levels of 64 slots cover 2^24 wheel ticks (about 4.6 hours at a
+ * 1 ms tick); longer delays are clamped. Expiry functions run in the
+ * tick timer's expiry context (an ISR), like k_timer expiry functions,
+ * and may start or stop wheel timers including their own.
+ */
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+#include <zephyr/kernel.h>
+
+#define TW_LEVEL_BITS 6
+#define TW_SLOTS BIT(TW_LEVEL_BITS)
+#define TW_LEVELS 4
+
+struct tw_timer;
+
+typedef void (*tw_expiry_t)(struct tw_timer *timer);
+
+struct tw_timer {
+	sys_dnode_t node;
+	tw_expiry_t expiry;
+	uint32_t expires;	/* wheel tick */
+	uint32_t period;	/* wheel ticks, 0 for one-shot */
+	void *user_data;
+};
+
+struct timer_wheel {
+	struct k_timer tick_timer;
+	uint32_t tick_ms;
+	uint32_t now;		/* wheel ticks since init */
+	struct k_spinlock lock;
+	sys_dlist_t slots[TW_LEVELS][TW_SLOTS];
+
+	/* Statistics */
+	uint32_t expired;
+	uint32_t cascaded;	/* moves to a lower level */
+};
+
+/* Set up @p tw with a tick of @p tick_ms; it does not advance until started */
+void timer_wheel_init(struct timer_wheel *tw, uint32_t tick_ms);
+
+void timer_wheel_start(struct timer_wheel *tw);
+void timer_wheel_stop(struct timer_wheel *tw);
+
+void tw_timer_init(struct tw_timer *timer, tw_expiry_t expiry,
+		   void *user_data);
+
+/*
+ * Start or restart @p timer to expire after @p delay_ms and then every
+ * @p period_ms (0 for one-shot). Times are rounded up to whole ticks.
+ */
+void tw_timer_start(struct timer_wheel *tw, struct tw_timer *timer,
+		    uint32_t delay_ms, uint32_t period_ms);
+
+/* Stop @p timer; does nothing if it is not running */
+void tw_timer_stop(struct timer_wheel *tw, struct tw_timer *timer);
+
+static inline bool tw_timer_is_running(const struct tw_timer *timer)
+{
+	return sys_dnode_is_linked(&timer->node);
+}
+
+#endif /* TIMER_WHEEL_H_ */
@@ -0,0 +1,18 @@
+/*
+ * Workqueue Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so use qemu or a real board for absolute latencies.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Completion latency of mixed short/long jobs: one queue vs the pool */
+void bench_ws_pool(void);
+
+/* ISR-side cost and handler runs per 1000 events: k_work vs coalescing */
+void bench_coalesce(void);
+
+#endif /* BENCH_H_ */
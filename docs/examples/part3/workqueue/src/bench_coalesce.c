@@ -0,0 +1,118 @@
+/*
+ * Coalescing Work Benchmark
+ *
+ * A k_timer expiry function stands in for a bursty interrupt: every
+ * tick it reports a burst of events, like a UART delivering several
+ * bytes per interrupt. Each event is submitted the way the example's
+ * sensor_work_ctx does it (store the value, k_work_submit()) and then
+ * through a coalescing work item. The table shows the ISR-side cost per
+ * event, how often the handler ran and how many of the events the
+ * handler was able to account for.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "coalesce_work.h"
+#include "bench.h"
+
+#define BENCH_EVENTS 1000
+#define BURST 10		/* events per timer interrupt */
+#define HANDLER_BUSY_US 200
+
+struct plain_ctx {
+	struct k_work work;
+	atomic_val_t value;
+};
+
+static struct plain_ctx plain;
+static struct coalesce_work coalesced;
+
+static K_SEM_DEFINE(events_done, 0, 1);
+static bool use_coalesce;
+static uint32_t fired;
+static uint64_t isr_total;	/* cycles, written only by the ISR */
+static uint32_t isr_max;
+
+/* Events the handler knows about */
+static atomic_t accounted;
+static atomic_t plain_runs;
+
+static void plain_handler(struct k_work *work)
+{
+	k_busy_wait(HANDLER_BUSY_US);
+	atomic_inc(&plain_runs);
+	atomic_inc(&accounted);	/* one run looks like one event */
+}
+
+static void coalesced_handler(struct coalesce_work *cw, uint32_t count,
+			      atomic_val_t payload)
+{
+	k_busy_wait(HANDLER_BUSY_US);
+	atomic_add(&accounted, count);
+}
+
+static void burst_expiry(struct k_timer *timer)
+{
+	for (int i = 0; i < BURST; i++) {
+		uint32_t start = k_cycle_get_32();
+
+		if (use_coalesce) {
+			coalesce_work_submit(&coalesced, fired);
+		} else {
+			plain.value = fired;
+			k_work_submit(&plain.work);
+		}
+
+		uint32_t cycles = k_cycle_get_32() - start;
+
+		isr_total += cycles;
+		isr_max = MAX(isr_max, cycles);
+		fired++;
+	}
+
+	if (fired >= BENCH_EVENTS) {
+		k_timer_stop(timer);
+		k_sem_give(&events_done);
+	}
+}
+
+static K_TIMER_DEFINE(burst_timer, burst_expiry, NULL);
+
+static void run(const char *name, bool coalesce, struct k_work *work)
+{
+	struct k_work_sync sync;
+
+	use_coalesce = coalesce;
+	fired = 0;
+	isr_total = 0;
+	isr_max = 0;
+	atomic_clear(&accounted);
+	atomic_clear(&plain_runs);
+
+	k_timer_start(&burst_timer, K_TICKS(1), K_TICKS(1));
+	k_sem_take(&events_done, K_FOREVER);
+	k_work_flush(work, &sync);
+
+	uint32_t runs = coalesce ? (uint32_t)atomic_get(&coalesced.runs) :
+		(uint32_t)atomic_get(&plain_runs);
+
+	printk("%-10s %10u %10u %8u %10u\n", name,
+	       (uint32_t)(isr_total / fired), isr_max,
+	       (uint32_t)((uint64_t)runs * 1000 / fired),
+	       (uint32_t)atomic_get(&accounted));
+}
+
+void bench_coalesce(void)
+{
+	printk("\n--- Benchmark: ISR event submission ---\n");
+	printk("%d events in bursts of %d, handler busy %d us\n",
+	       BENCH_EVENTS, BURST, HANDLER_BUSY_US);
+	printk("%-10s %10s %10s %8s %10s\n", "scheme", "isr avg", "isr max",
+	       "runs/1k", "accounted");
+
+	k_work_init(&plain.work, plain_handler);
+	run("k_work", false, &plain.work);
+
+	coalesce_work_init(&coalesced, coalesced_handler);
+	run("coalesce", true, &coalesced.work);
+}
@@ -0,0 +1,162 @@
+/*
+ * Work-Stealing Pool Benchmark
+ *
+ * Submits a stream of jobs one millisecond apart. Most jobs are short
+ * (busy for 200 us), every tenth one sleeps for 10 ms like
+ * simple_work_handler does. Completion latency runs from submit to the
+ * end of the handler and is reported separately for short and long
+ * jobs, first with all jobs on one dedicated work queue, then with a
+ * pool of workers without and with stealing.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "ws_pool.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define WORKER_PRIO 5
+#define BENCH_WORKERS 4
+#define BENCH_JOBS 200
+#define LONG_EVERY 10
+#define SHORT_BUSY_US 200
+#define LONG_SLEEP_MS 10
+
+struct bench_job {
+	struct k_work work;
+	uint32_t submitted;
+	uint32_t latency;
+	bool is_long;
+};
+
+K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static struct k_work_q single_q;
+
+WS_POOL_DEFINE(bench_pool, BENCH_WORKERS, STACK_SIZE);
+
+static struct bench_job jobs[BENCH_JOBS];
+static struct k_sem jobs_done;
+
+/* Latencies of one class, sorted for percentiles */
+static uint32_t sorted[BENCH_JOBS];
+
+static void job_handler(struct k_work *work)
+{
+	struct bench_job *job = CONTAINER_OF(work, struct bench_job, work);
+
+	if (job->is_long) {
+		k_msleep(LONG_SLEEP_MS);
+	} else {
+		k_busy_wait(SHORT_BUSY_US);
+	}
+
+	job->latency = k_cycle_get_32() - job->submitted;
+	k_sem_give(&jobs_done);
+}
+
+static size_t collect(bool is_long)
+{
+	size_t n = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(jobs); i++) {
+		if (jobs[i].is_long != is_long) {
+			continue;
+		}
+
+		/* Insertion sort; a couple of hundred entries at most */
+		size_t j = n++;
+
+		while (j > 0 && sorted[j - 1] > jobs[i].latency) {
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = jobs[i].latency;
+	}
+
+	return n;
+}
+
+/* @p pct_x10 / 10 percentile of the first @p n sorted entries, in us */
+static uint32_t percentile_us(size_t n, uint32_t pct_x10)
+{
+	size_t rank = ((uint64_t)n * pct_x10 + 999) / 1000;
+
+	return n ? k_cyc_to_us_floor32(sorted[MAX(rank, 1) - 1]) : 0;
+}
+
+static void report(const char *name, const char *kind, bool is_long)
+{
+	size_t n = collect(is_long);
+
+	printk("%-12s %-6s %8u %8u %8u\n", name, kind, percentile_us(n, 500),
+	       percentile_us(n, 990), percentile_us(n, 1000));
+}
+
+static void print_workers(struct ws_pool *pool)
+{
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		printk("  worker %zu: executed %u, stolen %u\n", i,
+		       (unsigned int)atomic_get(&pool->workers[i].executed),
+		       (unsigned int)atomic_get(&pool->workers[i].stolen));
+	}
+}
+
+static void run(const char *name, struct ws_pool *pool)
+{
+	k_sem_init(&jobs_done, 0, K_SEM_MAX_LIMIT);
+
+	if (pool != NULL) {
+		for (size_t i = 0; i < pool->num_workers; i++) {
+			atomic_clear(&pool->workers[i].executed);
+			atomic_clear(&pool->workers[i].stolen);
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(jobs); i++) {
+		jobs[i].is_long = (i % LONG_EVERY) == 0;
+		jobs[i].latency = 0;
+		k_work_init(&jobs[i].work, job_handler);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(jobs); i++) {
+		jobs[i].submitted = k_cycle_get_32();
+		if (pool != NULL) {
+			ws_pool_submit(pool, &jobs[i].work);
+		} else {
+			k_work_submit_to_queue(&single_q, &jobs[i].work);
+		}
+		k_msleep(1);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(jobs); i++) {
+		k_sem_take(&jobs_done, K_FOREVER);
+	}
+
+	report(name, "short", false);
+	report(name, "long", true);
+	if (pool != NULL) {
+		print_workers(pool);
+	}
+}
+
+void bench_ws_pool(void)
+{
+	printk("\n--- Benchmark: completion latency, mixed jobs ---\n");
+	printk("%d jobs, 1 in %d sleeps %d ms, %d pool workers\n", BENCH_JOBS,
+	       LONG_EVERY, LONG_SLEEP_MS, BENCH_WORKERS);
+	printk("%-12s %-6s %8s %8s %8s\n", "queue", "jobs", "p50 us",
+	       "p99 us", "max us");
+
+	k_work_queue_init(&single_q);
+	k_work_queue_start(&single_q, single_stack,
+			   K_THREAD_STACK_SIZEOF(single_stack), WORKER_PRIO,
+			   NULL);
+	run("single", NULL);
+
+	ws_pool_start(&bench_pool, WORKER_PRIO, "bench_ws");
+	bench_pool.steal = false;
+	run("pool", &bench_pool);
+
+	bench_pool.steal = true;
+	run("pool+steal", &bench_pool);
+}
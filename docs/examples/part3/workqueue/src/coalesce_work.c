@@ -0,0 +1,50 @@
+/*
+ * Coalescing Work Item
+ *
+ * The pending counter doubles as the "submitted" flag: only the event
+ * that moves it from zero submits the work item, and the handler takes
+ * the whole count with one atomic_clear(). An event that lands while
+ * the handler runs finds the counter at zero again and resubmits, which
+ * k_work_submit() honours for a running item, so no event is left
+ * without a handler run after it.
+ *
+ * The payload is stored before the count is raised. The payload a
+ * handler sees is therefore at least as new as the events it is told
+ * about, and may already belong to the next batch.
+ */
+
+#include "coalesce_work.h"
+
+static void coalesce_work_handler(struct k_work *work)
+{
+	struct coalesce_work *cw =
+		CONTAINER_OF(work, struct coalesce_work, work);
+	uint32_t count = (uint32_t)atomic_clear(&cw->pending);
+
+	atomic_inc(&cw->runs);
+	cw->handler(cw, count, atomic_get(&cw->latest));
+}
+
+void coalesce_work_init(struct coalesce_work *cw,
+			coalesce_work_handler_t handler)
+{
+	k_work_init(&cw->work, coalesce_work_handler);
+	cw->handler = handler;
+	atomic_clear(&cw->pending);
+	atomic_clear(&cw->latest);
+	atomic_clear(&cw->events);
+	atomic_clear(&cw->runs);
+}
+
+bool coalesce_work_submit(struct coalesce_work *cw, atomic_val_t payload)
+{
+	atomic_set(&cw->latest, payload);
+	atomic_inc(&cw->events);
+
+	if (atomic_inc(&cw->pending) != 0) {
+		return false;
+	}
+
+	k_work_submit(&cw->work);
+	return true;
+}
@@ -0,0 +1,47 @@
+/*
+ * Coalescing Work Item
+ *
+ * A work item for event sources that can fire faster than the handler
+ * runs. Each coalesce_work_submit() counts one event and stores its
+ * payload; the handler then gets the number of events since its last
+ * run and the latest payload. A plain k_work_submit() on a pending item
+ * is ignored, so the handler cannot tell one event from a burst.
+ *
+ * Submitting is ISR-safe and costs two atomic operations, plus a
+ * k_work_submit() for the first event of a batch only.
+ */
+
+#ifndef COALESCE_WORK_H_
+#define COALESCE_WORK_H_
+
+#include <zephyr/kernel.h>
+
+struct coalesce_work;
+
+/* @p count events arrived since the previous call; @p payload is the latest */
+typedef void (*coalesce_work_handler_t)(struct coalesce_work *cw,
+					 uint32_t count, atomic_val_t payload);
+
+struct coalesce_work {
+	struct k_work work;
+	coalesce_work_handler_t handler;
+	atomic_t pending;	/* events not yet handed to the handler */
+	atomic_t latest;
+
+	/* Statistics */
+	atomic_t events;
+	atomic_t runs;
+};
+
+void coalesce_work_init(struct coalesce_work *cw,
+			coalesce_work_handler_t handler);
+
+/**
+ * Record an event with @p payload and make sure the handler will run.
+ *
+ * @retval true This event submitted the work item.
+ * @retval false Merged into a batch that is already pending.
+ */
+bool coalesce_work_submit(struct coalesce_work *cw, atomic_val_t payload);
+
+#endif /* COALESCE_WORK_H_ */
@@ -6,6 +6,17 @@
 
 #include <zephyr/kernel.h>
 
+#include "ws_pool.h"
+#include "prio_wq.h"
+#include "coalesce_work.h"
+#include "work_trace.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define POOL_WORKERS 2
+#define POOL_PRIORITY 5
+#define PRIO_WQ_PRIORITY 2
+
 /* Work handlers */
 void simple_work_handler(struct k_work *work)
 {
@@ -31,12 +42,51 @@ void sensor_work_handler(struct k_work *work)
 	printk("[Sensor] Processing sensor value: %d\n", ctx->sensor_value);
 }
 
+/* Runs once per batch of readings, however many arrived */
+void sensor_burst_handler(struct coalesce_work *cw, uint32_t count,
+			  atomic_val_t payload)
+{
+	printk("[Sensor] %u readings merged, latest: %ld\n", count,
+	       (long)payload);
+}
+
+/* Sensor work as a prioritized item, with a deadline */
+struct sensor_prio_ctx {
+	struct prio_work work;
+	int sensor_value;
+};
+
+void sensor_prio_handler(struct k_work *work)
+{
+	struct sensor_prio_ctx *ctx = CONTAINER_OF(prio_work_from_work(work),
+						   struct sensor_prio_ctx, work);
+	printk("[Sensor] Urgent sensor value: %d\n", ctx->sensor_value);
+}
+
 /* Define work items */
 K_WORK_DEFINE(simple_work, simple_work_handler);
 K_WORK_DELAYABLE_DEFINE(delayed_work, delayed_work_handler);
+K_WORK_DEFINE(pool_work, simple_work_handler);
 
 static struct sensor_work_ctx sensor_ctx;
 
+static struct coalesce_work sensor_burst;
+
+/* The same handlers again, with queue wait and run time traced */
+WORK_TRACE_DEFINE(simple_work_handler);
+WORK_TRACE_DEFINE(delayed_work_handler);
+static struct work_trace_item traced_simple;
+static struct work_trace_item traced_delayed;
+
+/* Sensor work is latency-critical; slow work may not delay it */
+static PRIO_WORK_TYPE_DEFINE(sensor_type, "sensor");
+static PRIO_WORK_TYPE_DEFINE(slow_type, "slow");
+static struct sensor_prio_ctx urgent_sensor;
+static struct prio_work slow_work;
+
+/* Dedicated workers; a slow item no longer holds up the others */
+WS_POOL_DEFINE(app_pool, POOL_WORKERS, STACK_SIZE);
+
 /* Simulate ISR that submits work */
 void simulate_isr(void)
 {
@@ -48,6 +98,17 @@ void simulate_isr(void)
 	/* Submit work with context */
 	sensor_ctx.sensor_value = 42;
 	k_work_submit(&sensor_ctx.work);
+
+	/*
+	 * A burst of readings; the handler gets the count and the last one.
+	 * The scheduler lock keeps the workqueue out until the burst is
+	 * over, as a real ISR would.
+	 */
+	k_sched_lock();
+	for (int i = 0; i < 5; i++) {
+		coalesce_work_submit(&sensor_burst, 100 + i);
+	}
+	k_sched_unlock();
 }
 
 int main(void)
@@ -56,6 +117,7 @@ int main(void)
 
 	/* Initialize work with context */
 	k_work_init(&sensor_ctx.work, sensor_work_handler);
+	coalesce_work_init(&sensor_burst, sensor_burst_handler);
 
 	/* Submit simple work */
 	printk("Submitting simple work\n");
@@ -87,6 +149,44 @@ int main(void)
 	}
 
 	k_msleep(500);
+
+	/* Traced items: submitted like k_work_submit()/k_work_schedule() */
+	printk("Submitting traced work\n");
+	work_trace_init(&traced_simple, &simple_work_handler_trace);
+	work_trace_init(&traced_delayed, &delayed_work_handler_trace);
+	work_trace_submit(&traced_simple);
+	work_trace_schedule(&traced_delayed, K_MSEC(200));
+	k_msleep(500);
+
+	/* Slow low-class work cannot hold up urgent sensor work */
+	printk("Submitting prioritized work\n");
+	prio_wq_start(PRIO_WQ_PRIORITY);
+	prio_work_init(&urgent_sensor.work, sensor_prio_handler, &sensor_type,
+		       PRIO_WQ_HIGH);
+	prio_work_init(&slow_work, simple_work_handler, &slow_type,
+		       PRIO_WQ_LOW);
+	prio_work_submit(&slow_work, K_MSEC(50));
+	urgent_sensor.sensor_value = 42;
+	prio_work_submit(&urgent_sensor.work, K_MSEC(10));
+	k_msleep(500);
+
+	/* Same items on the pool: sensor work runs while simple work sleeps */
+	printk("Submitting to the work-stealing pool\n");
+	ws_pool_start(&app_pool, POOL_PRIORITY, "pool");
+	ws_pool_submit(&app_pool, &pool_work);
+	sensor_ctx.sensor_value = 43;
+	ws_pool_submit(&app_pool, &sensor_ctx.work);
+	k_msleep(500);
+
+	/* Deadline misses per work type */
+	prio_wq_dump();
+
+	/* Queue wait and run time per traced handler */
+	work_trace_dump();
+
+	bench_ws_pool();
+	bench_coalesce();
+
 	printk("Example complete\n");
 
 	return 0;
@@ -0,0 +1,218 @@
+/*
+ * Work-Stealing Worker Pool
+ *
+ * Every worker queue carries one "drain" work item. Submitting puts the
+ * user item on a deque and submits the owner's drain item; the drain
+ * handler then runs items until no deque it may take from has any left.
+ * Owners take their oldest item so their own items run in order,
+ * thieves take the newest one from the back. Because k_work_submit()
+ * requeues an item that is currently running, a push that races with a
+ * finishing drain handler is never left behind.
+ *
+ * One pool-wide spinlock covers the deques and each worker's running
+ * slot, so "is this item queued or running anywhere" and the push or
+ * pop that follows are one step. It is held only for a few pointer
+ * updates, never across a handler. An item that is running is only
+ * ever queued on its own worker, and thieves leave it alone, so its
+ * next run starts after the current one ends.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "ws_pool.h"
+
+/* Call with the pool lock held */
+static struct k_work *pop_oldest(struct ws_worker *w)
+{
+	struct k_work *work = NULL;
+
+	if (w->count > 0) {
+		work = w->items[w->head];
+		w->head = (w->head + 1) % WS_POOL_DEQUE_SIZE;
+		w->count--;
+	}
+
+	return work;
+}
+
+/* Call with the pool lock held */
+static struct k_work *pop_newest(struct ws_worker *w)
+{
+	struct k_work *work;
+
+	if (w->count == 0) {
+		return NULL;
+	}
+
+	work = w->items[(w->head + w->count - 1) % WS_POOL_DEQUE_SIZE];
+	if (work == w->running) {
+		return NULL;	/* queued again by its own handler */
+	}
+
+	w->count--;
+	return work;
+}
+
+/* Call with the pool lock held */
+static struct k_work *steal(struct ws_worker *self)
+{
+	struct ws_pool *pool = self->pool;
+	size_t me = self - pool->workers;
+
+	/* Start after ourselves so thieves spread over the victims */
+	for (size_t i = 1; i < pool->num_workers; i++) {
+		struct ws_worker *victim =
+			&pool->workers[(me + i) % pool->num_workers];
+		struct k_work *work = pop_newest(victim);
+
+		if (work != NULL) {
+			atomic_inc(&self->stolen);
+			return work;
+		}
+	}
+
+	return NULL;
+}
+
+static void drain_handler(struct k_work *drain)
+{
+	struct ws_worker *w = CONTAINER_OF(drain, struct ws_worker, drain);
+	struct ws_pool *pool = w->pool;
+	struct k_work *work;
+	k_spinlock_key_t key;
+
+	for (;;) {
+		key = k_spin_lock(&pool->lock);
+		work = pop_oldest(w);
+		if (work == NULL && pool->steal) {
+			work = steal(w);
+		}
+		w->running = work;
+		k_spin_unlock(&pool->lock, key);
+
+		if (work == NULL) {
+			break;
+		}
+
+		work->handler(work);
+		atomic_inc(&w->executed);
+
+		key = k_spin_lock(&pool->lock);
+		w->running = NULL;
+		k_spin_unlock(&pool->lock, key);
+	}
+}
+
+void ws_pool_start(struct ws_pool *pool, int prio, const char *name)
+{
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct ws_worker *w = &pool->workers[i];
+		char thread_name[16];
+		struct k_work_queue_config cfg = {
+			.name = thread_name,
+		};
+
+		snprintk(thread_name, sizeof(thread_name), "%s%zu", name, i);
+
+		w->pool = pool;
+		w->head = 0;
+		w->count = 0;
+		w->running = NULL;
+		k_work_init(&w->drain, drain_handler);
+		k_work_queue_init(&w->queue);
+		k_work_queue_start(&w->queue,
+				   pool->stacks + i * pool->stack_len,
+				   pool->stack_size, prio, &cfg);
+	}
+}
+
+/* Call with the pool lock held */
+static bool is_queued(struct ws_pool *pool, struct k_work *work)
+{
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct ws_worker *w = &pool->workers[i];
+
+		for (uint32_t n = 0; n < w->count; n++) {
+			if (w->items[(w->head + n) % WS_POOL_DEQUE_SIZE] ==
+			    work) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/* Queued items plus one for an item in progress */
+static uint32_t load(struct ws_worker *w)
+{
+	return w->count + (w->running != NULL ? 1 : 0);
+}
+
+/*
+ * Where @p work must go: its running worker, else the least loaded one
+ * with room. NULL when there is none.
+ */
+static struct ws_worker *pick_target(struct ws_pool *pool,
+				     struct k_work *work)
+{
+	size_t start = (size_t)atomic_inc(&pool->next) % pool->num_workers;
+	struct ws_worker *target = NULL;
+
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		if (pool->workers[i].running == work) {
+			return &pool->workers[i];
+		}
+	}
+
+	for (size_t i = 0; i < pool->num_workers; i++) {
+		struct ws_worker *w = &pool->workers[(start + i) % pool->num_workers];
+
+		if (w->count < WS_POOL_DEQUE_SIZE &&
+		    (target == NULL || load(w) < load(target))) {
+			target = w;
+		}
+	}
+
+	return target;
+}
+
+int ws_pool_submit(struct ws_pool *pool, struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+	struct ws_worker *target;
+	bool target_busy;
+
+	if (is_queued(pool, work)) {
+		k_spin_unlock(&pool->lock, key);
+		return 0;
+	}
+
+	target = pick_target(pool, work);
+	if (target == NULL || target->count == WS_POOL_DEQUE_SIZE) {
+		k_spin_unlock(&pool->lock, key);
+		return -EBUSY;
+	}
+
+	target->items[(target->head + target->count) % WS_POOL_DEQUE_SIZE] =
+		work;
+	target->count++;
+	target_busy = target->running != NULL && target->running != work;
+	k_spin_unlock(&pool->lock, key);
+
+	k_work_submit_to_queue(&target->queue, &target->drain);
+
+	/* The owner is stuck in a handler: let an idle worker take it */
+	if (pool->steal && target_busy) {
+		for (size_t i = 0; i < pool->num_workers; i++) {
+			struct ws_worker *w = &pool->workers[i];
+
+			if (w != target && w->running == NULL) {
+				k_work_submit_to_queue(&w->queue, &w->drain);
+				break;
+			}
+		}
+	}
+
+	return 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * Work-Stealing Worker Pool
+ *
+ * A pool of N dedicated k_work queues for ordinary struct k_work
+ * items. Each worker owns a small deque of submitted items. When a
+ * worker blocks in a slow handler, an idle worker is woken and steals
+ * from the busy worker's deque, so one slow item no longer holds up
+ * everything queued behind it.
+ *
+ * Items are initialized with k_work_init() as usual and submitted with
+ * ws_pool_submit() instead of k_work_submit(). The pool runs handlers
+ * itself, so pool items never enter the k_work state machine:
+ *
+ *   - k_work_is_pending(), k_work_busy_get(), k_work_cancel() and
+ *     k_work_flush() know nothing about them
+ *   - an item must not be submitted to the pool and to a kernel work
+ *     queue at the same time
+ *
+ * What does hold, as for k_work_submit(): an item is queued at most
+ * once and never runs on two workers at once. Submitting an item while
+ * it runs queues it again on the worker running it.
+ */
+
+#ifndef WS_POOL_H_
+#define WS_POOL_H_
+
+#include <zephyr/kernel.h>
+
+/* Items each worker can hold queued */
+#define WS_POOL_DEQUE_SIZE 16
+
+struct ws_pool;
+
+struct ws_worker {
+	struct k_work_q queue;
+	struct k_work drain;		/* runs items from the deques */
+	struct ws_pool *pool;
+
+	/* Under the pool lock */
+	struct k_work *items[WS_POOL_DEQUE_SIZE];
+	uint32_t head;			/* oldest item */
+	uint32_t count;
+	struct k_work *running;		/* item in its handler, or NULL */
+
+	atomic_t executed;
+	atomic_t stolen;		/* items taken from other workers */
+};
+
+struct ws_pool {
+	struct k_spinlock lock;		/* all deques and running slots */
+	struct ws_worker *workers;
+	size_t num_workers;
+	k_thread_stack_t *stacks;
+	size_t stack_len;		/* stride between stacks */
+	size_t stack_size;
+	bool steal;			/* false: plain per-worker queues */
+	atomic_t next;			/* round-robin start for placement */
+};
+
+/**
+ * Statically define pool @p name with @p n workers, each with a stack of
+ * @p ssize bytes. Start it with ws_pool_start().
+ */
+#define WS_POOL_DEFINE(name, n, ssize)                                     \
+	K_THREAD_STACK_ARRAY_DEFINE(_ws_stacks_##name, n, ssize);          \
+	static struct ws_worker _ws_workers_##name[n];                     \
+	static struct ws_pool name = {                                     \
+		.workers = _ws_workers_##name,                             \
+		.num_workers = (n),                                        \
+		.stacks = &_ws_stacks_##name[0][0],                        \
+		.stack_len = K_THREAD_STACK_LEN(ssize),                    \
+		.stack_size = K_THREAD_STACK_SIZEOF(_ws_stacks_##name[0]), \
+		.steal = true,                                             \
+	}
+
+/* Start the worker threads at priority @p prio; @p name prefixes thread names */
+void ws_pool_start(struct ws_pool *pool, int prio, const char *name);
+
+/**
+ * Queue @p work on the least loaded worker, or on the worker running
+ * it if it is in its handler right now.
+ *
+ * @retval 1 Item queued.
+ * @retval 0 Item was already queued in the pool (like k_work_submit()).
+ * @retval -EBUSY Every deque is full, or the one of the worker running
+ *                @p work is.
+ */
+int ws_pool_submit(struct ws_pool *pool, struct k_work *work);
+
+#endif /* WS_POOL_H_ */
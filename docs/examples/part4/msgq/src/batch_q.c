@@ -0,0 +1,145 @@
+/*
+ * Batch Message Queue
+ *
+ * The doorbell semaphores have a limit of 1, so a burst of batches
+ * leaves at most one pending wakeup and wakes one waiter. Every put and
+ * get that leaves data (or space) behind rings again while others still
+ * wait, so the wakeup is passed on until the waiters are served or the
+ * ring runs dry. A waiter that wakes and finds nothing to do simply
+ * waits again until its deadline.
+ */
+
+#include <string.h>
+
+#include "batch_q.h"
+
+void batch_q_init(struct batch_q *q, char *buf, size_t msg_size,
+		  uint32_t max_msgs)
+{
+	*q = (struct batch_q){
+		.buf = buf,
+		.msg_size = msg_size,
+		.max_msgs = max_msgs,
+	};
+
+	k_sem_init(&q->data_avail, 0, 1);
+	k_sem_init(&q->space_avail, 0, 1);
+}
+
+/* Release the lock, then ring the doorbells the state it saw allows */
+static void unlock_and_wake(struct batch_q *q, k_spinlock_key_t key)
+{
+	bool data = q->used > 0 && q->consumers_waiting > 0;
+	bool space = q->used < q->max_msgs && q->producers_waiting > 0;
+
+	k_spin_unlock(&q->lock, key);
+
+	if (data) {
+		k_sem_give(&q->data_avail);
+	}
+	if (space) {
+		k_sem_give(&q->space_avail);
+	}
+}
+
+/* Copy @p n messages into the ring starting at slot @p idx */
+static void ring_write(struct batch_q *q, uint32_t idx, const char *src,
+		       uint32_t n)
+{
+	uint32_t first = MIN(n, q->max_msgs - idx);
+
+	memcpy(q->buf + idx * q->msg_size, src, first * q->msg_size);
+	memcpy(q->buf, src + first * q->msg_size, (n - first) * q->msg_size);
+}
+
+/* Copy @p n messages out of the ring starting at slot @p idx */
+static void ring_read(struct batch_q *q, uint32_t idx, char *dst,
+		      uint32_t n)
+{
+	uint32_t first = MIN(n, q->max_msgs - idx);
+
+	memcpy(dst, q->buf + idx * q->msg_size, first * q->msg_size);
+	memcpy(dst + first * q->msg_size, q->buf, (n - first) * q->msg_size);
+}
+
+int batch_q_put(struct batch_q *q, const void *msgs, uint32_t count,
+		k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&q->lock);
+		uint32_t n = MIN(count, q->max_msgs - q->used);
+
+		if (n > 0) {
+			uint32_t write_idx = (q->read_idx + q->used) % q->max_msgs;
+
+			ring_write(q, write_idx, msgs, n);
+			q->used += n;
+			q->put_calls++;
+			q->msgs += n;
+
+			/* One wakeup for the whole batch */
+			unlock_and_wake(q, key);
+			return n;
+		}
+
+		q->producer_waits++;
+		q->producers_waiting++;
+		k_spin_unlock(&q->lock, key);
+
+		int ret = k_sem_take(&q->space_avail, sys_timepoint_timeout(end));
+
+		key = k_spin_lock(&q->lock);
+		q->producers_waiting--;
+		k_spin_unlock(&q->lock, key);
+
+		if (ret != 0) {
+			return -EAGAIN;
+		}
+	}
+}
+
+int batch_q_get(struct batch_q *q, void *msgs, uint32_t max_count,
+		k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&q->lock);
+		uint32_t n = MIN(max_count, q->used);
+
+		if (n > 0) {
+			ring_read(q, q->read_idx, msgs, n);
+			q->read_idx = (q->read_idx + n) % q->max_msgs;
+			q->used -= n;
+			q->get_calls++;
+
+			unlock_and_wake(q, key);
+			return n;
+		}
+
+		q->consumer_waits++;
+		q->consumers_waiting++;
+		k_spin_unlock(&q->lock, key);
+
+		int ret = k_sem_take(&q->data_avail, sys_timepoint_timeout(end));
+
+		key = k_spin_lock(&q->lock);
+		q->consumers_waiting--;
+		k_spin_unlock(&q->lock, key);
+
+		if (ret != 0) {
+			return -EAGAIN;
+		}
+	}
+}
+
+uint32_t batch_q_num_used_get(struct batch_q *q)
+{
+	k_spinlock_key_t key = k_spin_lock(&q->lock);
+	uint32_t used = q->used;
+
+	k_spin_unlock(&q->lock, key);
+	return used;
+}
@@ -0,0 +1,62 @@
+/*
+ * Batch Message Queue
+ *
+ * A fixed-size message ring, like k_msgq, whose put and get move up
+ * to N messages under one spinlock acquisition. A waiting consumer is
+ * woken once per batch instead of once per message, and a waiting
+ * producer once per drained batch. Any number of producers and
+ * consumers may share the queue.
+ */
+
+#ifndef BATCH_Q_H_
+#define BATCH_Q_H_
+
+#include <zephyr/kernel.h>
+
+struct batch_q {
+	struct k_spinlock lock;
+	char *buf;
+	size_t msg_size;
+	uint32_t max_msgs;
+	uint32_t read_idx;
+	uint32_t used;
+
+	/* Doorbells: rung while someone waits and could now proceed */
+	struct k_sem data_avail;
+	struct k_sem space_avail;
+	uint32_t consumers_waiting;
+	uint32_t producers_waiting;
+
+	/* Statistics */
+	uint32_t put_calls;
+	uint32_t get_calls;
+	uint32_t msgs;
+	uint32_t consumer_waits;
+	uint32_t producer_waits;
+};
+
+/* @p buf must hold @p max_msgs messages of @p msg_size bytes */
+void batch_q_init(struct batch_q *q, char *buf, size_t msg_size,
+		  uint32_t max_msgs);
+
+/**
+ * Copy up to @p count messages from @p msgs into the queue, waiting
+ * up to @p timeout for room if the queue is full.
+ *
+ * @return Number of messages queued (1..count), or -EAGAIN on timeout.
+ */
+int batch_q_put(struct batch_q *q, const void *msgs, uint32_t count,
+		k_timeout_t timeout);
+
+/**
+ * Copy up to @p max_count queued messages into @p msgs, waiting up to
+ * @p timeout for at least one if the queue is empty.
+ *
+ * @return Number of messages received (1..max_count), or -EAGAIN.
+ */
+int batch_q_get(struct batch_q *q, void *msgs, uint32_t max_count,
+		k_timeout_t timeout);
+
+uint32_t batch_q_num_used_get(struct batch_q *q);
+
+#endif /* BATCH_Q_H_ */
@@ -0,0 +1,22 @@
+/*
+ * Message Queue Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so compare message counts there and use qemu or a
+ * real board for absolute throughput and latency.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Copying k_msgq vs zero-copy queue for payloads of 8 B to 4 KB */
+void bench_payload_sizes(void);
+
+/* Batched put/get with batch sizes 1, 4, 16 and 64 */
+void bench_batch_sizes(void);
+
+/* Fast producer vs slow consumer under each backpressure policy */
+void bench_backpressure(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,99 @@
+/*
+ * Backpressure Policy Benchmark
+ *
+ * A producer sampling every millisecond feeds a consumer that needs
+ * three milliseconds per message through a short queue. The same run
+ * is repeated for every policy and the per-policy counters printed.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "sensor_msg.h"
+#include "bp_queue.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BP_SAMPLES 100
+#define BP_QUEUE_LEN 4
+#define BP_PRODUCER_PERIOD_MS 1
+#define BP_CONSUMER_COST_MS 3
+
+static const enum bp_policy policies[] = {
+	BP_BLOCK, BP_DROP_OLDEST, BP_DROP_NEWEST, BP_DOWNSAMPLE,
+};
+
+K_THREAD_STACK_DEFINE(bp_tx_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(bp_rx_stack, STACK_SIZE);
+static struct k_thread bp_tx_thread;
+static struct k_thread bp_rx_thread;
+
+static char __aligned(4) bp_ring[BP_QUEUE_LEN * sizeof(struct sensor_msg)];
+static struct k_msgq bp_msgq;
+static struct bp_queue bench_bp;
+
+static volatile bool producer_done;
+static uint32_t consumed;
+
+static void bp_tx_entry(void *p1, void *p2, void *p3)
+{
+	struct sensor_msg msg = { .humidity = 500 };
+
+	for (int i = 0; i < BP_SAMPLES; i++) {
+		msg.timestamp = k_uptime_get_32();
+		msg.temperature = 200 + (i % 10);
+		bp_queue_put(&bench_bp, &msg);
+		k_msleep(BP_PRODUCER_PERIOD_MS);
+	}
+
+	bp_queue_flush(&bench_bp, K_FOREVER);
+	producer_done = true;
+}
+
+static void bp_rx_entry(void *p1, void *p2, void *p3)
+{
+	struct sensor_msg msg;
+
+	while (!producer_done || k_msgq_num_used_get(&bp_msgq) > 0) {
+		if (k_msgq_get(&bp_msgq, &msg, K_MSEC(10)) == 0) {
+			consumed++;
+			k_msleep(BP_CONSUMER_COST_MS);
+		}
+	}
+}
+
+void bench_backpressure(void)
+{
+	printk("\n--- Benchmark: backpressure policies ---\n");
+	printk("%d samples every %d ms, consumer %d ms/msg, queue length %d\n",
+	       BP_SAMPLES, BP_PRODUCER_PERIOD_MS, BP_CONSUMER_COST_MS,
+	       BP_QUEUE_LEN);
+	printk("%-12s %6s %8s %7s %7s %8s %8s\n", "policy", "sent",
+	       "dropped", "merged", "delayed", "received", "time ms");
+
+	for (size_t i = 0; i < ARRAY_SIZE(policies); i++) {
+		k_msgq_init(&bp_msgq, bp_ring, sizeof(struct sensor_msg),
+			    BP_QUEUE_LEN);
+		bp_queue_init(&bench_bp, &bp_msgq, policies[i], K_MSEC(5),
+			      sensor_msg_merge);
+		producer_done = false;
+		consumed = 0;
+
+		k_thread_create(&bp_rx_thread, bp_rx_stack, STACK_SIZE,
+				bp_rx_entry, NULL, NULL, NULL, 6, 0, K_FOREVER);
+		k_thread_create(&bp_tx_thread, bp_tx_stack, STACK_SIZE,
+				bp_tx_entry, NULL, NULL, NULL, 5, 0, K_FOREVER);
+
+		int64_t start = k_uptime_get();
+
+		k_thread_start(&bp_rx_thread);
+		k_thread_start(&bp_tx_thread);
+		k_thread_join(&bp_tx_thread, K_FOREVER);
+		k_thread_join(&bp_rx_thread, K_FOREVER);
+
+		printk("%-12s %6u %8u %7u %7u %8u %8u\n",
+		       bp_policy_name(policies[i]), bench_bp.stats.sent,
+		       bench_bp.stats.dropped, bench_bp.stats.merged,
+		       bench_bp.stats.delayed, consumed,
+		       (uint32_t)(k_uptime_get() - start));
+	}
+}
@@ -0,0 +1,159 @@
+/*
+ * Batch Size Benchmark
+ *
+ * Streams sensor messages from a producer to a consumer through a
+ * batch_q using batch sizes 1, 4, 16 and 64, with plain k_msgq as a
+ * reference. Each time a thread has to wait on the queue it is
+ * switched out and later woken, so waits per message approximate
+ * context switches per message.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "sensor_msg.h"
+#include "batch_q.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BATCH_TOTAL_MSGS 2048
+#define BATCH_QUEUE_LEN 64
+#define BATCH_MAX 64
+
+static const uint32_t batch_sizes[] = { 1, 4, 16, 64 };
+
+K_THREAD_STACK_DEFINE(batch_tx_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(batch_rx_stack, STACK_SIZE);
+static struct k_thread batch_tx_thread;
+static struct k_thread batch_rx_thread;
+
+static char __aligned(4) batch_ring[BATCH_QUEUE_LEN * sizeof(struct sensor_msg)];
+static struct batch_q bench_q;
+static struct k_msgq ref_msgq;
+
+/* Per-thread staging arrays for one batch */
+static struct sensor_msg tx_batch[BATCH_MAX];
+static struct sensor_msg rx_batch[BATCH_MAX];
+
+static void batch_tx_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t batch = POINTER_TO_UINT(p1);
+	uint32_t sent = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (sent < BATCH_TOTAL_MSGS) {
+		uint32_t n = MIN(batch, BATCH_TOTAL_MSGS - sent);
+
+		for (uint32_t i = 0; i < n; i++) {
+			tx_batch[i].timestamp = sent + i;
+			tx_batch[i].temperature = 200;
+			tx_batch[i].humidity = 500;
+		}
+
+		/* A batch may be split if the queue is nearly full */
+		for (uint32_t done = 0; done < n;) {
+			int ret = batch_q_put(&bench_q, &tx_batch[done],
+					      n - done, K_FOREVER);
+
+			if (ret > 0) {
+				done += ret;
+			}
+		}
+		sent += n;
+	}
+}
+
+static void batch_rx_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t batch = POINTER_TO_UINT(p1);
+	uint32_t received = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (received < BATCH_TOTAL_MSGS) {
+		int ret = batch_q_get(&bench_q, rx_batch, batch, K_FOREVER);
+
+		if (ret > 0) {
+			received += ret;
+		}
+	}
+}
+
+static void msgq_tx_entry(void *p1, void *p2, void *p3)
+{
+	struct sensor_msg msg = { .temperature = 200, .humidity = 500 };
+
+	for (uint32_t i = 0; i < BATCH_TOTAL_MSGS; i++) {
+		msg.timestamp = i;
+		k_msgq_put(&ref_msgq, &msg, K_FOREVER);
+	}
+}
+
+static void msgq_rx_entry(void *p1, void *p2, void *p3)
+{
+	struct sensor_msg msg;
+
+	for (uint32_t i = 0; i < BATCH_TOTAL_MSGS; i++) {
+		k_msgq_get(&ref_msgq, &msg, K_FOREVER);
+	}
+}
+
+/* Run producer (prio 5) and consumer (prio 6); return elapsed cycles */
+static uint32_t run_pair(k_thread_entry_t tx, k_thread_entry_t rx, void *arg)
+{
+	k_thread_create(&batch_rx_thread, batch_rx_stack, STACK_SIZE,
+			rx, arg, NULL, NULL, 6, 0, K_FOREVER);
+	k_thread_create(&batch_tx_thread, batch_tx_stack, STACK_SIZE,
+			tx, arg, NULL, NULL, 5, 0, K_FOREVER);
+
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_start(&batch_rx_thread);
+	k_thread_start(&batch_tx_thread);
+	k_thread_join(&batch_tx_thread, K_FOREVER);
+	k_thread_join(&batch_rx_thread, K_FOREVER);
+
+	return k_cycle_get_32() - start;
+}
+
+static uint64_t msgs_per_sec(uint32_t elapsed)
+{
+	return elapsed ? (uint64_t)BATCH_TOTAL_MSGS *
+		sys_clock_hw_cycles_per_sec() / elapsed : 0;
+}
+
+void bench_batch_sizes(void)
+{
+	printk("\n--- Benchmark: batched put/get ---\n");
+	printk("%d messages of %u bytes, queue length %d\n", BATCH_TOTAL_MSGS,
+	       (unsigned int)sizeof(struct sensor_msg), BATCH_QUEUE_LEN);
+	printk("%-8s %10s %6s %6s %12s\n", "batch", "msgs/s", "puts", "gets",
+	       "waits/msg");
+
+	k_msgq_init(&ref_msgq, batch_ring, sizeof(struct sensor_msg),
+		    BATCH_QUEUE_LEN);
+	uint32_t elapsed = run_pair(msgq_tx_entry, msgq_rx_entry, NULL);
+
+	printk("%-8s %10llu %6u %6u %12s\n", "k_msgq",
+	       (unsigned long long)msgs_per_sec(elapsed),
+	       BATCH_TOTAL_MSGS, BATCH_TOTAL_MSGS, "-");
+
+	for (size_t i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		batch_q_init(&bench_q, batch_ring, sizeof(struct sensor_msg),
+			     BATCH_QUEUE_LEN);
+		elapsed = run_pair(batch_tx_entry, batch_rx_entry,
+				   UINT_TO_POINTER(batch_sizes[i]));
+
+		/* Waits per message, in thousandths */
+		uint32_t waits = bench_q.consumer_waits + bench_q.producer_waits;
+		uint32_t milli = (uint32_t)(((uint64_t)waits * 1000) /
+					    bench_q.msgs);
+
+		printk("%-8u %10llu %6u %6u %8u.%03u\n", batch_sizes[i],
+		       (unsigned long long)msgs_per_sec(elapsed),
+		       bench_q.put_calls, bench_q.get_calls,
+		       milli / 1000, milli % 1000);
+	}
+}
@@ -0,0 +1,180 @@
+/*
+ * Payload Size Benchmark
+ *
+ * Sends the same stream of messages through a copying k_msgq and a
+ * zero-copy queue for payload sizes from 8 B to 4 KB, and reports
+ * throughput and put-to-get latency for each.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "zc_queue.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_MSGS 200
+#define BENCH_DEPTH 4
+#define BENCH_BLOCKS (BENCH_DEPTH + 2)
+#define MAX_PAYLOAD 4096
+
+static const uint16_t payload_sizes[] = { 8, 64, 256, 1024, 4096 };
+
+/* Start of every payload; the rest is waveform samples */
+struct payload_hdr {
+	uint32_t seq;
+	uint32_t t_put;
+};
+
+K_THREAD_STACK_DEFINE(bench_tx_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(bench_rx_stack, STACK_SIZE);
+static struct k_thread bench_tx_thread;
+static struct k_thread bench_rx_thread;
+
+/* Ring storage for the copying queue, or slab storage for zero-copy */
+static char __aligned(8) payload_buf[MAX_PAYLOAD * BENCH_BLOCKS];
+static char __aligned(sizeof(void *)) ptr_buf[sizeof(void *) * BENCH_DEPTH];
+
+static struct k_msgq copy_msgq;
+static struct k_msgq ptr_msgq;
+static struct k_mem_slab zc_slab;
+static struct zc_queue zc_q;
+
+/* Producer/consumer staging buffers for the copying queue */
+static uint8_t tx_buf[MAX_PAYLOAD];
+static uint8_t rx_buf[MAX_PAYLOAD];
+
+struct bench_run {
+	size_t size;
+	bool zero_copy;
+	uint32_t received;
+	uint32_t out_of_order;
+	uint32_t lat_total;
+	uint32_t lat_max;
+};
+
+static void fill_payload(uint8_t *buf, size_t size, uint32_t seq)
+{
+	struct payload_hdr *hdr = (struct payload_hdr *)buf;
+
+	hdr->seq = seq;
+	memset(buf + sizeof(*hdr), seq & 0xff, size - sizeof(*hdr));
+}
+
+static void bench_tx_entry(void *p1, void *p2, void *p3)
+{
+	struct bench_run *run = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+		if (run->zero_copy) {
+			uint8_t *block = zc_queue_alloc(&zc_q, K_FOREVER);
+
+			fill_payload(block, run->size, i);
+			((struct payload_hdr *)block)->t_put = k_cycle_get_32();
+			zc_queue_put(&zc_q, block, K_FOREVER);
+		} else {
+			fill_payload(tx_buf, run->size, i);
+			((struct payload_hdr *)tx_buf)->t_put = k_cycle_get_32();
+			k_msgq_put(&copy_msgq, tx_buf, K_FOREVER);
+		}
+	}
+}
+
+static void bench_rx_entry(void *p1, void *p2, void *p3)
+{
+	struct bench_run *run = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < BENCH_MSGS; i++) {
+		const struct payload_hdr *hdr;
+		void *block = NULL;
+
+		if (run->zero_copy) {
+			zc_queue_get(&zc_q, &block, K_FOREVER);
+			hdr = block;
+		} else {
+			k_msgq_get(&copy_msgq, rx_buf, K_FOREVER);
+			hdr = (const struct payload_hdr *)rx_buf;
+		}
+
+		uint32_t latency = k_cycle_get_32() - hdr->t_put;
+
+		run->received++;
+		run->lat_total += latency;
+		run->lat_max = MAX(run->lat_max, latency);
+		if (hdr->seq != i) {
+			run->out_of_order++;
+		}
+
+		if (block != NULL) {
+			zc_queue_free(&zc_q, block);
+		}
+	}
+}
+
+static void run_once(struct bench_run *run)
+{
+	if (run->zero_copy) {
+		int ret = k_mem_slab_init(&zc_slab, payload_buf, run->size,
+					  BENCH_BLOCKS);
+
+		if (ret != 0) {
+			printk("%6u %-6s (slab rejected: %d)\n",
+			       (unsigned int)run->size, "zcopy", ret);
+			return;
+		}
+		k_msgq_init(&ptr_msgq, ptr_buf, sizeof(void *), BENCH_DEPTH);
+		zc_queue_init(&zc_q, &ptr_msgq, &zc_slab);
+	} else {
+		k_msgq_init(&copy_msgq, payload_buf, run->size, BENCH_DEPTH);
+	}
+
+	k_thread_create(&bench_rx_thread, bench_rx_stack, STACK_SIZE,
+			bench_rx_entry, run, NULL, NULL, 6, 0, K_FOREVER);
+	k_thread_create(&bench_tx_thread, bench_tx_stack, STACK_SIZE,
+			bench_tx_entry, run, NULL, NULL, 5, 0, K_FOREVER);
+
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_start(&bench_rx_thread);
+	k_thread_start(&bench_tx_thread);
+	k_thread_join(&bench_tx_thread, K_FOREVER);
+	k_thread_join(&bench_rx_thread, K_FOREVER);
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+	uint64_t msgs_per_sec = elapsed ? (uint64_t)run->received *
+		sys_clock_hw_cycles_per_sec() / elapsed : 0;
+
+	printk("%6u %-6s %10llu %10u %10u %4u\n",
+	       (unsigned int)run->size, run->zero_copy ? "zcopy" : "copy",
+	       (unsigned long long)msgs_per_sec,
+	       run->received ? run->lat_total / run->received : 0,
+	       run->lat_max, run->out_of_order);
+}
+
+void bench_payload_sizes(void)
+{
+	printk("\n--- Benchmark: copying k_msgq vs zero-copy queue ---\n");
+	printk("%d messages per run, queue depth %d\n", BENCH_MSGS, BENCH_DEPTH);
+	printk("%6s %-6s %10s %10s %10s %4s\n", "bytes", "mode", "msgs/s",
+	       "avg cyc", "max cyc", "ooo");
+
+	for (size_t i = 0; i < ARRAY_SIZE(payload_sizes); i++) {
+		struct bench_run copy = {
+			.size = payload_sizes[i],
+			.zero_copy = false,
+		};
+		struct bench_run zcopy = {
+			.size = payload_sizes[i],
+			.zero_copy = true,
+		};
+
+		run_once(&copy);
+		run_once(&zcopy);
+	}
+}
@@ -0,0 +1,138 @@
+/*
+ * Backpressure Policy Layer
+ */
+
+#include <string.h>
+
+#include "bp_queue.h"
+
+void bp_queue_init(struct bp_queue *bq, struct k_msgq *msgq,
+		   enum bp_policy policy, k_timeout_t deadline,
+		   bp_merge_t merge)
+{
+	__ASSERT(policy != BP_DOWNSAMPLE || merge != NULL,
+		 "downsampling needs a merge function");
+	__ASSERT(policy != BP_DOWNSAMPLE || msgq->msg_size <= BP_MAX_MSG_SIZE,
+		 "message too large to downsample");
+
+	*bq = (struct bp_queue){
+		.msgq = msgq,
+		.policy = policy,
+		.deadline = deadline,
+		.merge = merge,
+	};
+}
+
+static int put_block(struct bp_queue *bq, const void *msg)
+{
+	if (k_msgq_put(bq->msgq, msg, K_NO_WAIT) == 0) {
+		bq->stats.sent++;
+		return 0;
+	}
+
+	bq->stats.delayed++;
+	if (k_msgq_put(bq->msgq, msg, bq->deadline) == 0) {
+		bq->stats.sent++;
+		return 0;
+	}
+
+	bq->stats.dropped++;
+	return -ENOMSG;
+}
+
+static int put_drop_oldest(struct bp_queue *bq, const void *msg)
+{
+	uint8_t discard[BP_MAX_MSG_SIZE];
+
+	__ASSERT_NO_MSG(bq->msgq->msg_size <= sizeof(discard));
+
+	/* The consumer may drain in between; retry until the put lands */
+	while (k_msgq_put(bq->msgq, msg, K_NO_WAIT) != 0) {
+		if (k_msgq_get(bq->msgq, discard, K_NO_WAIT) == 0) {
+			bq->stats.dropped++;
+		}
+	}
+
+	bq->stats.sent++;
+	return 0;
+}
+
+static int put_drop_newest(struct bp_queue *bq, const void *msg)
+{
+	if (k_msgq_put(bq->msgq, msg, K_NO_WAIT) == 0) {
+		bq->stats.sent++;
+		return 0;
+	}
+
+	bq->stats.dropped++;
+	return -ENOMSG;
+}
+
+static int put_downsample(struct bp_queue *bq, const void *msg)
+{
+	/* Older merged data goes first to keep samples in order */
+	if (bq->pending_count > 0 && bp_queue_flush(bq, K_NO_WAIT) != 0) {
+		bq->merge(bq->pending, msg, bq->pending_count);
+		bq->pending_count++;
+		bq->stats.merged++;
+		return -EBUSY;
+	}
+
+	if (k_msgq_put(bq->msgq, msg, K_NO_WAIT) == 0) {
+		bq->stats.sent++;
+		return 0;
+	}
+
+	/* Queue full: hold this sample back and merge followers into it */
+	memcpy(bq->pending, msg, bq->msgq->msg_size);
+	bq->pending_count = 1;
+	return -EBUSY;
+}
+
+int bp_queue_put(struct bp_queue *bq, const void *msg)
+{
+	switch (bq->policy) {
+	case BP_BLOCK:
+		return put_block(bq, msg);
+	case BP_DROP_OLDEST:
+		return put_drop_oldest(bq, msg);
+	case BP_DROP_NEWEST:
+		return put_drop_newest(bq, msg);
+	case BP_DOWNSAMPLE:
+		return put_downsample(bq, msg);
+	default:
+		return -EINVAL;
+	}
+}
+
+int bp_queue_flush(struct bp_queue *bq, k_timeout_t timeout)
+{
+	if (bq->pending_count == 0) {
+		return 0;
+	}
+
+	int ret = k_msgq_put(bq->msgq, bq->pending, timeout);
+
+	if (ret == 0) {
+		bq->stats.sent++;
+		bq->pending_count = 0;
+	}
+
+	return ret;
+}
+
+const char *bp_policy_name(enum bp_policy policy)
+{
+	switch (policy) {
+	case BP_BLOCK:
+		return "block";
+	case BP_DROP_OLDEST:
+		return "drop-oldest";
+	case BP_DROP_NEWEST:
+		return "drop-newest";
+	case BP_DOWNSAMPLE:
+		return "downsample";
+	default:
+		return "unknown";
+	}
+}
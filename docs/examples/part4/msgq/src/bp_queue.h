@@ -0,0 +1,82 @@
+/*
+ * Backpressure Policy Layer
+ *
+ * Wraps a k_msgq so that a producer facing a full queue follows an
+ * explicit policy instead of silently dropping, and every sample that
+ * is dropped, merged or delayed is counted. A bp_queue is meant for a
+ * single producer thread; consumers use the underlying k_msgq as usual.
+ */
+
+#ifndef BP_QUEUE_H_
+#define BP_QUEUE_H_
+
+#include <zephyr/kernel.h>
+
+/* Largest message a bp_queue can hold back for downsampling */
+#define BP_MAX_MSG_SIZE 32
+
+enum bp_policy {
+	/* Wait for room up to a deadline, then drop the new sample */
+	BP_BLOCK,
+	/* Discard the oldest queued sample to make room */
+	BP_DROP_OLDEST,
+	/* Discard the new sample */
+	BP_DROP_NEWEST,
+	/* Merge samples into one pending sample until there is room */
+	BP_DOWNSAMPLE,
+};
+
+/**
+ * Fold @p sample into @p acc, which already represents @p acc_count
+ * samples (for example, update a running average).
+ */
+typedef void (*bp_merge_t)(void *acc, const void *sample, uint32_t acc_count);
+
+struct bp_stats {
+	uint32_t sent;		/* samples that entered the queue */
+	uint32_t dropped;	/* samples lost */
+	uint32_t merged;	/* samples folded into another one */
+	uint32_t delayed;	/* puts that had to wait for room */
+};
+
+struct bp_queue {
+	struct k_msgq *msgq;
+	enum bp_policy policy;
+	k_timeout_t deadline;
+	bp_merge_t merge;
+
+	/* BP_DOWNSAMPLE: sample waiting for room, and how many it holds */
+	uint32_t pending_count;
+	uint8_t __aligned(4) pending[BP_MAX_MSG_SIZE];
+
+	struct bp_stats stats;
+};
+
+/*
+ * Set up @p bq in front of @p msgq. BP_BLOCK waits up to @p deadline;
+ * BP_DOWNSAMPLE requires @p merge. Unused arguments may be K_NO_WAIT
+ * and NULL.
+ */
+void bp_queue_init(struct bp_queue *bq, struct k_msgq *msgq,
+		   enum bp_policy policy, k_timeout_t deadline,
+		   bp_merge_t merge);
+
+/**
+ * Offer one sample to the queue according to the policy.
+ *
+ * @retval 0 Sample queued (possibly after dropping an older one).
+ * @retval -EBUSY Sample held back for downsampling, either starting the
+ *                pending sample or merged into it.
+ * @retval -ENOMSG Sample dropped.
+ */
+int bp_queue_put(struct bp_queue *bq, const void *msg);
+
+/**
+ * Push a pending downsampled sample, waiting up to @p timeout.
+ * Call when the producer stops so merged data is not lost.
+ */
+int bp_queue_flush(struct bp_queue *bq, k_timeout_t timeout);
+
+const char *bp_policy_name(enum bp_policy policy);
+
+#endif /* BP_QUEUE_H_ */
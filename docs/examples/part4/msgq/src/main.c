@@ -1,12 +1,18 @@
 /*
  * Message Queue Example
  *
- * Demonstrates fixed-size message passing between threads.
+ * Demonstrates fixed-size message passing between threads, and a
+ * zero-copy mode that passes slab block pointers for large payloads.
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/random/random.h>
 
+#include "sensor_msg.h"
+#include "zc_queue.h"
+#include "bp_queue.h"
+#include "bench.h"
+
 #define STACK_SIZE 1024
 
 K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
@@ -15,16 +21,12 @@ K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
 static struct k_thread producer_thread;
 static struct k_thread consumer_thread;
 
-/* Message structure */
-struct sensor_msg {
-	uint32_t timestamp;
-	int16_t temperature;
-	int16_t humidity;
-};
-
 /* Define message queue: message size, max count, alignment */
 K_MSGQ_DEFINE(sensor_msgq, sizeof(struct sensor_msg), 10, 4);
 
+/* Producer-side backpressure: average samples while the queue is full */
+static struct bp_queue sensor_bp;
+
 /* Simulated sensor reading using hardware RNG */
 static int16_t read_temperature(void)
 {
@@ -44,19 +46,24 @@ void producer_entry(void *p1, void *p2, void *p3)
 {
 	struct sensor_msg msg;
 
+	bp_queue_init(&sensor_bp, &sensor_msgq, BP_DOWNSAMPLE, K_NO_WAIT,
+		      sensor_msg_merge);
+
 	for (int i = 0; i < 20; i++) {
 		/* Read sensors */
 		msg.timestamp = k_uptime_get_32();
 		msg.temperature = read_temperature();
 		msg.humidity = read_humidity();
 
-		/* Send message */
-		int ret = k_msgq_put(&sensor_msgq, &msg, K_NO_WAIT);
+		/* Send message; a full queue is handled by the policy */
+		int ret = bp_queue_put(&sensor_bp, &msg);
 		if (ret == 0) {
 			printk("[Producer] Sent: temp=%d.%d°C, hum=%d.%d%% @ %u\n",
 			       msg.temperature / 10, msg.temperature % 10,
 			       msg.humidity / 10, msg.humidity % 10,
 			       msg.timestamp);
+		} else if (ret == -EBUSY) {
+			printk("[Producer] Queue full, held back for downsampling\n");
 		} else {
 			printk("[Producer] Queue full, dropping message\n");
 		}
@@ -64,7 +71,13 @@ void producer_entry(void *p1, void *p2, void *p3)
 		k_msleep(200);
 	}
 
-	printk("[Producer] Done\n");
+	/* Deliver any merged sample still held back */
+	bp_queue_flush(&sensor_bp, K_MSEC(1000));
+
+	printk("[Producer] Done (%s: sent=%u dropped=%u merged=%u delayed=%u)\n",
+	       bp_policy_name(sensor_bp.policy), sensor_bp.stats.sent,
+	       sensor_bp.stats.dropped, sensor_bp.stats.merged,
+	       sensor_bp.stats.delayed);
 }
 
 void consumer_entry(void *p1, void *p2, void *p3)
@@ -96,6 +109,88 @@ void consumer_entry(void *p1, void *p2, void *p3)
 	printk("[Consumer] Done\n");
 }
 
+/* ---- Zero-copy mode for large payloads ---- */
+
+#define WAVEFORM_SAMPLES 120
+
+struct waveform_msg {
+	uint32_t timestamp;
+	uint16_t count;
+	int16_t samples[WAVEFORM_SAMPLES];
+};
+
+/* 6 blocks of waveform_msg, up to 4 queued at once */
+ZC_QUEUE_DEFINE(waveform_q, sizeof(struct waveform_msg), 6, 4);
+
+void zc_producer_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 5; i++) {
+		/* Fill the payload directly in a slab block */
+		struct waveform_msg *msg = zc_queue_alloc(&waveform_q, K_MSEC(100));
+
+		if (msg == NULL) {
+			printk("[ZC Producer] No free block, dropping waveform\n");
+			continue;
+		}
+
+		uint32_t timestamp = k_uptime_get_32();
+		uint32_t count = WAVEFORM_SAMPLES;
+
+		msg->timestamp = timestamp;
+		msg->count = count;
+		for (int j = 0; j < WAVEFORM_SAMPLES; j++) {
+			msg->samples[j] = read_temperature();
+		}
+
+		/*
+		 * Only the pointer goes through the queue. Once it is in,
+		 * the block belongs to the consumer, so msg is not read
+		 * again after a successful put.
+		 */
+		if (zc_queue_put(&waveform_q, msg, K_NO_WAIT) != 0) {
+			printk("[ZC Producer] Queue full, dropping waveform\n");
+			zc_queue_free(&waveform_q, msg);
+		} else {
+			printk("[ZC Producer] Sent %u samples (%u bytes) @ %u\n",
+			       count, (unsigned int)sizeof(*msg),
+			       timestamp);
+		}
+
+		k_msleep(200);
+	}
+
+	printk("[ZC Producer] Done\n");
+}
+
+void zc_consumer_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 5; i++) {
+		void *block;
+
+		if (zc_queue_get(&waveform_q, &block, K_MSEC(1000)) != 0) {
+			printk("[ZC Consumer] Timeout waiting for waveform\n");
+			break;
+		}
+
+		struct waveform_msg *msg = block;
+		int16_t min = msg->samples[0];
+		int16_t max = msg->samples[0];
+
+		for (int j = 1; j < msg->count; j++) {
+			min = MIN(min, msg->samples[j]);
+			max = MAX(max, msg->samples[j]);
+		}
+
+		printk("[ZC Consumer] Waveform @ %u: min=%d.%d max=%d.%d\n",
+		       msg->timestamp, min / 10, min % 10, max / 10, max % 10);
+
+		/* Consumer owns the block until it frees it */
+		zc_queue_free(&waveform_q, block);
+	}
+
+	printk("[ZC Consumer] Done\n");
+}
+
 int main(void)
 {
 	printk("Message Queue Example\n");
@@ -114,6 +209,26 @@ int main(void)
 	k_thread_join(&producer_thread, K_FOREVER);
 	k_thread_join(&consumer_thread, K_FOREVER);
 
+	printk("\nZero-copy queue: %u-byte waveforms\n",
+	       (unsigned int)sizeof(struct waveform_msg));
+
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			zc_producer_entry, NULL, NULL, NULL,
+			5, 0, K_NO_WAIT);
+	k_thread_name_set(&producer_thread, "zc_producer");
+
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			zc_consumer_entry, NULL, NULL, NULL,
+			6, 0, K_NO_WAIT);
+	k_thread_name_set(&consumer_thread, "zc_consumer");
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	bench_payload_sizes();
+	bench_batch_sizes();
+	bench_backpressure();
+
 	printk("Example complete\n");
 
 	return 0;
@@ -0,0 +1,32 @@
+/*
+ * Sensor message passed through the queues
+ */
+
+#ifndef SENSOR_MSG_H_
+#define SENSOR_MSG_H_
+
+#include <zephyr/kernel.h>
+
+struct sensor_msg {
+	uint32_t timestamp;
+	int16_t temperature;
+	int16_t humidity;
+};
+
+/*
+ * Fold @p sample into @p acc, which already averages @p acc_count
+ * samples. The merged message keeps the newest timestamp.
+ */
+static inline void sensor_msg_merge(void *acc, const void *sample,
+				    uint32_t acc_count)
+{
+	struct sensor_msg *a = acc;
+	const struct sensor_msg *s = sample;
+	int32_t n = acc_count;
+
+	a->temperature = (a->temperature * n + s->temperature) / (n + 1);
+	a->humidity = (a->humidity * n + s->humidity) / (n + 1);
+	a->timestamp = s->timestamp;
+}
+
+#endif /* SENSOR_MSG_H_ */
@@ -0,0 +1,42 @@
+/*
+ * Zero-Copy Queue
+ */
+
+#include "zc_queue.h"
+
+void zc_queue_init(struct zc_queue *q, struct k_msgq *msgq,
+		   struct k_mem_slab *slab)
+{
+	__ASSERT(msgq->msg_size == sizeof(void *),
+		 "zero-copy msgq must carry pointers");
+
+	q->msgq = msgq;
+	q->slab = slab;
+}
+
+void *zc_queue_alloc(struct zc_queue *q, k_timeout_t timeout)
+{
+	void *block;
+
+	if (k_mem_slab_alloc(q->slab, &block, timeout) != 0) {
+		return NULL;
+	}
+
+	return block;
+}
+
+int zc_queue_put(struct zc_queue *q, void *block, k_timeout_t timeout)
+{
+	/* Only the pointer is copied into the queue */
+	return k_msgq_put(q->msgq, &block, timeout);
+}
+
+int zc_queue_get(struct zc_queue *q, void **block, k_timeout_t timeout)
+{
+	return k_msgq_get(q->msgq, block, timeout);
+}
+
+void zc_queue_free(struct zc_queue *q, void *block)
+{
+	k_mem_slab_free(q->slab, block);
+}
@@ -0,0 +1,57 @@
+/*
+ * Zero-Copy Queue
+ *
+ * A message queue that moves only pointers. The producer allocates a
+ * block from the queue's memory slab, fills it in place and enqueues
+ * the pointer; the consumer dequeues the pointer, uses the block and
+ * frees it. Payload bytes are never copied, whatever their size.
+ */
+
+#ifndef ZC_QUEUE_H_
+#define ZC_QUEUE_H_
+
+#include <zephyr/kernel.h>
+
+struct zc_queue {
+	struct k_msgq *msgq;
+	struct k_mem_slab *slab;
+};
+
+/*
+ * Define a zero-copy queue with @p num_blocks payload blocks of
+ * @p block_size bytes, of which up to @p depth can be queued at once.
+ * Allow num_blocks > depth so the producer can fill the next block
+ * while the consumer still holds one.
+ */
+#define ZC_QUEUE_DEFINE(name, block_size, num_blocks, depth)		\
+	K_MEM_SLAB_DEFINE_STATIC(name##_slab, block_size, num_blocks, 4); \
+	K_MSGQ_DEFINE(name##_msgq, sizeof(void *), depth, sizeof(void *)); \
+	static struct zc_queue name = {					\
+		.msgq = &name##_msgq,					\
+		.slab = &name##_slab,					\
+	}
+
+/* Attach a runtime-initialized pointer msgq and slab */
+void zc_queue_init(struct zc_queue *q, struct k_msgq *msgq,
+		   struct k_mem_slab *slab);
+
+/* Get an empty block to fill; NULL if none is free within @p timeout */
+void *zc_queue_alloc(struct zc_queue *q, k_timeout_t timeout);
+
+/*
+ * Enqueue a filled block. On success ownership passes to the consumer;
+ * on failure the caller still owns the block and must free it.
+ */
+int zc_queue_put(struct zc_queue *q, void *block, k_timeout_t timeout);
+
+/* Dequeue a block; the caller must zc_queue_free() it when done */
+int zc_queue_get(struct zc_queue *q, void **block, k_timeout_t timeout);
+
+void zc_queue_free(struct zc_queue *q, void *block);
+
+static inline uint32_t zc_queue_num_used_get(struct zc_queue *q)
+{
+	return k_msgq_num_used_get(q->msgq);
+}
+
+#endif /* ZC_QUEUE_H_ */
@@ -0,0 +1,16 @@
+/*
+ * Mutex Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so rely on the exactness checks there and use qemu
+ * or a real board for absolute throughput.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Mutex vs atomic_inc vs sharded counter at 2, 4 and 8 threads */
+void bench_counter(void);
+
+#endif /* BENCH_H_ */
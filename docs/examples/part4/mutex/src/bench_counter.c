@@ -0,0 +1,129 @@
+/*
+ * Counter Contention Benchmark
+ *
+ * 2, 4 and 8 threads each increment one shared counter a fixed number
+ * of times. The counter is guarded by a K_MUTEX_DEFINE mutex, or is a
+ * single atomic_t, or is a sharded counter. Threads yield now and then
+ * so they interleave even on a single CPU. Each row also checks that
+ * the final count is exact.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "sharded_counter.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define MAX_THREADS 8
+#define INCREMENTS 20000
+#define YIELD_EVERY 64
+#define BENCH_PRIO 7
+
+static const uint32_t thread_counts[] = { 2, 4, 8 };
+
+enum counter_kind {
+	COUNTER_MUTEX,
+	COUNTER_ATOMIC,
+	COUNTER_SHARDED,
+};
+
+static const char *const kind_names[] = {
+	[COUNTER_MUTEX] = "mutex",
+	[COUNTER_ATOMIC] = "atomic_inc",
+	[COUNTER_SHARDED] = "sharded",
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(counter_stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread counter_threads[MAX_THREADS];
+
+K_MUTEX_DEFINE(bench_mutex);
+static int64_t mutex_count;
+static atomic_t atomic_count;
+SHARDED_COUNTER_DEFINE(sharded_count);
+
+static void counter_entry(void *p1, void *p2, void *p3)
+{
+	enum counter_kind kind = POINTER_TO_UINT(p1);
+
+	for (int i = 1; i <= INCREMENTS; i++) {
+		switch (kind) {
+		case COUNTER_MUTEX:
+			k_mutex_lock(&bench_mutex, K_FOREVER);
+			mutex_count++;
+			k_mutex_unlock(&bench_mutex);
+			break;
+		case COUNTER_ATOMIC:
+			atomic_inc(&atomic_count);
+			break;
+		case COUNTER_SHARDED:
+			sharded_counter_inc(&sharded_count);
+			break;
+		}
+
+		if ((i % YIELD_EVERY) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static int64_t read_count(enum counter_kind kind)
+{
+	switch (kind) {
+	case COUNTER_MUTEX:
+		return mutex_count;
+	case COUNTER_ATOMIC:
+		return atomic_get(&atomic_count);
+	case COUNTER_SHARDED:
+		return sharded_counter_read(&sharded_count);
+	}
+
+	return 0;
+}
+
+static void run(enum counter_kind kind, uint32_t threads)
+{
+	mutex_count = 0;
+	atomic_clear(&atomic_count);
+	sharded_counter_reset(&sharded_count);
+
+	for (uint32_t i = 0; i < threads; i++) {
+		k_thread_create(&counter_threads[i], counter_stacks[i],
+				STACK_SIZE, counter_entry,
+				UINT_TO_POINTER(kind), NULL, NULL,
+				BENCH_PRIO, 0, K_FOREVER);
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < threads; i++) {
+		k_thread_start(&counter_threads[i]);
+	}
+	for (uint32_t i = 0; i < threads; i++) {
+		k_thread_join(&counter_threads[i], K_FOREVER);
+	}
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+	uint64_t total = (uint64_t)threads * INCREMENTS;
+	uint64_t per_sec = elapsed ? total * sys_clock_hw_cycles_per_sec() /
+		elapsed : 0;
+	int64_t count = read_count(kind);
+
+	printk("%-11s %7u %12llu %9llu  %s\n", kind_names[kind], threads,
+	       (unsigned long long)per_sec, (unsigned long long)count,
+	       count == (int64_t)total ? "exact" : "LOST UPDATES");
+}
+
+void bench_counter(void)
+{
+	printk("\n--- Benchmark: shared counter contention ---\n");
+	printk("%d increments per thread, yield every %d\n", INCREMENTS,
+	       YIELD_EVERY);
+	printk("%-11s %7s %12s %9s\n", "counter", "threads", "incs/s",
+	       "final");
+
+	for (size_t i = 0; i < ARRAY_SIZE(thread_counts); i++) {
+		for (int kind = COUNTER_MUTEX; kind <= COUNTER_SHARDED; kind++) {
+			run(kind, thread_counts[i]);
+		}
+	}
+}
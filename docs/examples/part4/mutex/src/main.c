@@ -6,6 +6,10 @@
 
 #include <zephyr/kernel.h>
 
+#include "lock_prof.h"
+#include "sharded_counter.h"
+#include "bench.h"
+
 #define STACK_SIZE 1024
 
 K_THREAD_STACK_DEFINE(thread1_stack, STACK_SIZE);
@@ -16,8 +20,12 @@ static struct k_thread thread2_data;
 
 /* Shared resource protected by mutex */
 K_MUTEX_DEFINE(counter_mutex);
+LOCK_PROF_DEFINE(counter_mutex);
 static int shared_counter = 0;
 
+/* Statistics counter that needs no mutex at all */
+SHARDED_COUNTER_DEFINE(event_counter);
+
 /* Thread that increments counter */
 void increment_thread(void *p1, void *p2, void *p3)
 {
@@ -25,17 +33,21 @@ void increment_thread(void *p1, void *p2, void *p3)
 
 	for (int i = 0; i < 10; i++) {
 		/* Lock mutex before accessing shared resource */
-		k_mutex_lock(&counter_mutex, K_FOREVER);
+		lock_prof_lock(&counter_mutex_prof, K_FOREVER);
 
 		/* Critical section - safe to access shared_counter */
 		int local = shared_counter;
+		/*
+		 * Sleeping here widens the critical section to show the
+		 * mutex at work; real code keeps it as short as possible.
+		 */
 		k_msleep(10);  /* Simulate some work */
 		shared_counter = local + 1;
 
 		printk("[%s] Counter: %d -> %d\n", name, local, shared_counter);
 
 		/* Unlock mutex */
-		k_mutex_unlock(&counter_mutex);
+		lock_prof_unlock(&counter_mutex_prof);
 
 		/* Small delay between iterations */
 		k_msleep(50);
@@ -44,6 +56,15 @@ void increment_thread(void *p1, void *p2, void *p3)
 	printk("[%s] Done\n", name);
 }
 
+/* Thread that counts events with the sharded counter, no lock needed */
+void count_events_thread(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 10; i++) {
+		sharded_counter_inc(&event_counter);
+		k_msleep(5);
+	}
+}
+
 int main(void)
 {
 	k_tid_t tid1, tid2;
@@ -67,6 +88,22 @@ int main(void)
 	k_thread_join(&thread2_data, K_FOREVER);
 
 	printk("Final counter: %d (expected: 20)\n", shared_counter);
+	lock_prof_dump();
+
+	/* Same count without serializing the threads */
+	k_thread_create(&thread1_data, thread1_stack, STACK_SIZE,
+			count_events_thread, NULL, NULL, NULL,
+			5, 0, K_NO_WAIT);
+	k_thread_create(&thread2_data, thread2_stack, STACK_SIZE,
+			count_events_thread, NULL, NULL, NULL,
+			5, 0, K_NO_WAIT);
+	k_thread_join(&thread1_data, K_FOREVER);
+	k_thread_join(&thread2_data, K_FOREVER);
+
+	printk("Sharded counter: %lld (expected: 20)\n",
+	       (long long)sharded_counter_read(&event_counter));
+
+	bench_counter();
 
 	return 0;
 }
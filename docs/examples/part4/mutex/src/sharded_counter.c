@@ -0,0 +1,23 @@
+/*
+ * Sharded Counter
+ */
+
+#include "sharded_counter.h"
+
+int64_t sharded_counter_read(struct sharded_counter *c)
+{
+	int64_t sum = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(c->shard); i++) {
+		sum += atomic_get(&c->shard[i].value);
+	}
+
+	return sum;
+}
+
+void sharded_counter_reset(struct sharded_counter *c)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(c->shard); i++) {
+		atomic_clear(&c->shard[i].value);
+	}
+}
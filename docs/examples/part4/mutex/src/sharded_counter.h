@@ -0,0 +1,62 @@
+/*
+ * Sharded Counter
+ *
+ * A statistics counter that many threads can bump without a lock. The
+ * count is split over several slots, each on its own cache line, and a
+ * thread always adds to the slot picked from its thread ID. Threads
+ * therefore rarely share a slot, and never lose an update even when they
+ * do, because every slot is updated atomically. A read sums all slots.
+ */
+
+#ifndef SHARDED_COUNTER_H_
+#define SHARDED_COUNTER_H_
+
+#include <zephyr/kernel.h>
+
+#define SHARDED_COUNTER_SHARDS 8
+#define SHARDED_COUNTER_ALIGN 64	/* keep slots on separate cache lines */
+
+struct sharded_counter {
+	struct {
+		atomic_t value;
+	} __aligned(SHARDED_COUNTER_ALIGN) shard[SHARDED_COUNTER_SHARDS];
+};
+
+#define SHARDED_COUNTER_DEFINE(name) static struct sharded_counter name
+
+/* Slot used by the calling thread */
+static inline uint32_t sharded_counter_shard(void)
+{
+	/*
+	 * Thread objects often sit in arrays whose stride is a multiple of
+	 * the shard count, so mix the address bits before reducing them.
+	 */
+	uint32_t id = (uint32_t)((uintptr_t)k_current_get() >> 3);
+
+	return ((id * 2654435761U) >> 16) % SHARDED_COUNTER_SHARDS;
+}
+
+static inline void sharded_counter_add(struct sharded_counter *c,
+				       atomic_val_t delta)
+{
+	atomic_add(&c->shard[sharded_counter_shard()].value, delta);
+}
+
+static inline void sharded_counter_inc(struct sharded_counter *c)
+{
+	sharded_counter_add(c, 1);
+}
+
+/**
+ * Sum all slots.
+ *
+ * No increment is ever lost, so once the writers are done the result
+ * is exact. While writers are still running, the result lies between
+ * the count when the read started and the count when it finished.
+ */
+int64_t sharded_counter_read(struct sharded_counter *c);
+
+/* Zero all slots; increments racing with the reset may survive it */
+void sharded_counter_reset(struct sharded_counter *c);
+
+#endif /* SHARDED_COUNTER_H_ */
@@ -0,0 +1,19 @@
+/*
+ * Semaphore Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so compare item counts and wait counts there and use
+ * qemu or a real board for absolute throughput and latency.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Semaphore+mutex bounded buffer vs lock-free SPSC ring */
+void bench_spsc(void);
+
+/* Semaphore+mutex buffer, k_msgq and MPMC queue with 1-8 threads a side */
+void bench_mpmc(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,240 @@
+/*
+ * MPMC Queue Benchmark
+ *
+ * N producers each send a fixed share of items to N consumers through
+ * three queues: the example's semaphore + single mutex bounded buffer,
+ * k_msgq, and the lock-free MPMC queue. All threads share one priority.
+ *
+ * Fairness is Jain's index (1.000 means perfectly even) over
+ *   - consumers: items each consumer received;
+ *   - producers: items each producer got delivered during the first half
+ *     of the run, while every producer was still competing.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "mpmc_queue.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define MAX_SIDE 8
+#define TOTAL_ITEMS 8000	/* divisible by every side count */
+#define QUEUE_SLOTS 16
+#define BENCH_PRIO 7
+
+static const uint32_t side_counts[] = { 1, 2, 4, 8 };
+
+struct item {
+	uint16_t producer;
+	uint16_t seq;
+};
+
+enum scheme {
+	SCHEME_SEM_MUTEX,
+	SCHEME_MSGQ,
+	SCHEME_MPMC,
+};
+
+static const char *const scheme_names[] = {
+	[SCHEME_SEM_MUTEX] = "sem+mutex",
+	[SCHEME_MSGQ] = "k_msgq",
+	[SCHEME_MPMC] = "mpmc",
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(mpmc_stacks, 2 * MAX_SIDE, STACK_SIZE);
+static struct k_thread mpmc_threads[2 * MAX_SIDE];
+
+/* Semaphore + mutex bounded buffer, as in the example */
+static struct item ref_buffer[QUEUE_SLOTS];
+static int ref_write_idx;
+static int ref_read_idx;
+static struct k_sem ref_empty;
+static struct k_sem ref_full;
+static struct k_mutex ref_mutex;
+
+static char __aligned(4) msgq_buf[QUEUE_SLOTS * sizeof(struct item)];
+static struct k_msgq ref_msgq;
+
+MPMC_QUEUE_DEFINE(fanin_q, sizeof(struct item), QUEUE_SLOTS);
+
+static enum scheme cur_scheme;
+static uint32_t per_producer;
+static atomic_t consumed;
+static uint32_t end_cycles;
+static uint32_t consumer_items[MAX_SIDE];
+static atomic_t early_items[MAX_SIDE];	/* updated by every consumer */
+
+static void put_item(const struct item *it)
+{
+	switch (cur_scheme) {
+	case SCHEME_SEM_MUTEX:
+		k_sem_take(&ref_empty, K_FOREVER);
+		k_mutex_lock(&ref_mutex, K_FOREVER);
+		ref_buffer[ref_write_idx] = *it;
+		ref_write_idx = (ref_write_idx + 1) % QUEUE_SLOTS;
+		k_mutex_unlock(&ref_mutex);
+		k_sem_give(&ref_full);
+		break;
+	case SCHEME_MSGQ:
+		k_msgq_put(&ref_msgq, it, K_FOREVER);
+		break;
+	case SCHEME_MPMC:
+		mpmc_queue_put(&fanin_q, it, K_FOREVER);
+		break;
+	}
+}
+
+/* Consumers poll with a timeout so they can notice the run is over */
+static int get_item(struct item *it)
+{
+	switch (cur_scheme) {
+	case SCHEME_SEM_MUTEX:
+		if (k_sem_take(&ref_full, K_MSEC(10)) != 0) {
+			return -EAGAIN;
+		}
+		k_mutex_lock(&ref_mutex, K_FOREVER);
+		*it = ref_buffer[ref_read_idx];
+		ref_read_idx = (ref_read_idx + 1) % QUEUE_SLOTS;
+		k_mutex_unlock(&ref_mutex);
+		k_sem_give(&ref_empty);
+		return 0;
+	case SCHEME_MSGQ:
+		return k_msgq_get(&ref_msgq, it, K_MSEC(10));
+	case SCHEME_MPMC:
+		return mpmc_queue_get(&fanin_q, it, K_MSEC(10));
+	}
+
+	return -EINVAL;
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct item it = { .producer = POINTER_TO_UINT(p1) };
+
+	for (uint32_t i = 0; i < per_producer; i++) {
+		it.seq = i;
+		put_item(&it);
+	}
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+	struct item it;
+
+	while (atomic_get(&consumed) < TOTAL_ITEMS) {
+		if (get_item(&it) != 0) {
+			continue;
+		}
+
+		atomic_val_t n = atomic_inc(&consumed) + 1;
+
+		consumer_items[id]++;
+		if (n <= TOTAL_ITEMS / 2) {
+			atomic_inc(&early_items[it.producer]);
+		}
+		if (n == TOTAL_ITEMS) {
+			end_cycles = k_cycle_get_32();
+		}
+	}
+}
+
+/* Jain's fairness index of @p n values, in thousandths */
+static uint32_t jain_x1000(const uint32_t *v, uint32_t n)
+{
+	uint64_t sum = 0;
+	uint64_t sum_sq = 0;
+
+	for (uint32_t i = 0; i < n; i++) {
+		sum += v[i];
+		sum_sq += (uint64_t)v[i] * v[i];
+	}
+
+	return sum_sq ? (uint32_t)(sum * sum * 1000 / (n * sum_sq)) : 0;
+}
+
+static void reset_scheme(enum scheme s)
+{
+	switch (s) {
+	case SCHEME_SEM_MUTEX:
+		k_sem_init(&ref_empty, QUEUE_SLOTS, QUEUE_SLOTS);
+		k_sem_init(&ref_full, 0, QUEUE_SLOTS);
+		k_mutex_init(&ref_mutex);
+		ref_write_idx = 0;
+		ref_read_idx = 0;
+		break;
+	case SCHEME_MSGQ:
+		k_msgq_init(&ref_msgq, msgq_buf, sizeof(struct item),
+			    QUEUE_SLOTS);
+		break;
+	case SCHEME_MPMC:
+		mpmc_queue_init(&fanin_q);
+		break;
+	}
+}
+
+static void run(enum scheme s, uint32_t n)
+{
+	reset_scheme(s);
+	cur_scheme = s;
+	per_producer = TOTAL_ITEMS / n;
+	atomic_set(&consumed, 0);
+	memset(consumer_items, 0, sizeof(consumer_items));
+	memset(early_items, 0, sizeof(early_items));
+
+	for (uint32_t i = 0; i < 2 * n; i++) {
+		bool producer = i < n;
+
+		k_thread_create(&mpmc_threads[i], mpmc_stacks[i], STACK_SIZE,
+				producer ? producer_entry : consumer_entry,
+				UINT_TO_POINTER(producer ? i : i - n), NULL, NULL,
+				BENCH_PRIO, 0, K_FOREVER);
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < 2 * n; i++) {
+		k_thread_start(&mpmc_threads[i]);
+	}
+	for (uint32_t i = 0; i < 2 * n; i++) {
+		k_thread_join(&mpmc_threads[i], K_FOREVER);
+	}
+
+	uint32_t elapsed = end_cycles - start;
+	uint64_t per_sec = elapsed ? (uint64_t)TOTAL_ITEMS *
+		sys_clock_hw_cycles_per_sec() / elapsed : 0;
+	uint32_t early[MAX_SIDE];
+
+	for (uint32_t i = 0; i < n; i++) {
+		early[i] = atomic_get(&early_items[i]);
+	}
+
+	uint32_t cons_fair = jain_x1000(consumer_items, n);
+	uint32_t prod_fair = jain_x1000(early, n);
+
+	printk("%-10s %3u %10llu %5u.%03u %5u.%03u",
+	       scheme_names[s], n, (unsigned long long)per_sec,
+	       prod_fair / 1000, prod_fair % 1000,
+	       cons_fair / 1000, cons_fair % 1000);
+	if (s == SCHEME_MPMC) {
+		printk("  (%u CAS collisions)",
+		       (uint32_t)atomic_get(&fanin_q.collisions));
+	}
+	printk("\n");
+}
+
+void bench_mpmc(void)
+{
+	printk("\n--- Benchmark: MPMC fan-in ---\n");
+	printk("%d items, %d slots, N producers and N consumers\n",
+	       TOTAL_ITEMS, QUEUE_SLOTS);
+	printk("%-10s %3s %10s %9s %9s\n", "scheme", "N", "items/s",
+	       "prod fair", "cons fair");
+
+	for (size_t i = 0; i < ARRAY_SIZE(side_counts); i++) {
+		for (int s = SCHEME_SEM_MUTEX; s <= SCHEME_MPMC; s++) {
+			run(s, side_counts[i]);
+		}
+	}
+}
@@ -0,0 +1,133 @@
+/*
+ * SPSC Ring Benchmark
+ *
+ * Streams timestamped items from one producer to one consumer, first
+ * through the empty_slots/full_slots/buffer_mutex bounded buffer used by
+ * the example and then through the lock-free SPSC ring. The consumer
+ * runs at the higher priority, so each item is normally handed over
+ * right away and the latency is the cost of the handoff itself.
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "lat_hist.h"
+#include "spsc_ring.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_ITEMS 10000
+#define BENCH_SLOTS 8
+
+K_THREAD_STACK_DEFINE(bench_tx_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(bench_rx_stack, STACK_SIZE);
+static struct k_thread bench_tx_thread;
+static struct k_thread bench_rx_thread;
+
+/* Reference: the example's semaphore + mutex bounded buffer */
+static uint32_t ref_buffer[BENCH_SLOTS];
+static int ref_write_idx;
+static int ref_read_idx;
+static struct k_sem ref_empty;
+static struct k_sem ref_full;
+static struct k_mutex ref_mutex;
+
+SPSC_RING_DEFINE(bench_ring, sizeof(uint32_t), BENCH_SLOTS);
+
+static struct lat_hist hist;
+
+static void record_latency(uint32_t stamp)
+{
+	lat_hist_add(&hist, k_cycle_get_32() - stamp);
+}
+
+static void ref_tx_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BENCH_ITEMS; i++) {
+		k_sem_take(&ref_empty, K_FOREVER);
+		k_mutex_lock(&ref_mutex, K_FOREVER);
+		ref_buffer[ref_write_idx] = k_cycle_get_32();
+		ref_write_idx = (ref_write_idx + 1) % BENCH_SLOTS;
+		k_mutex_unlock(&ref_mutex);
+		k_sem_give(&ref_full);
+	}
+}
+
+static void ref_rx_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BENCH_ITEMS; i++) {
+		k_sem_take(&ref_full, K_FOREVER);
+		k_mutex_lock(&ref_mutex, K_FOREVER);
+		uint32_t stamp = ref_buffer[ref_read_idx];
+
+		ref_read_idx = (ref_read_idx + 1) % BENCH_SLOTS;
+		k_mutex_unlock(&ref_mutex);
+		k_sem_give(&ref_empty);
+
+		record_latency(stamp);
+	}
+}
+
+static void ring_tx_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BENCH_ITEMS; i++) {
+		uint32_t stamp = k_cycle_get_32();
+
+		spsc_ring_put(&bench_ring, &stamp, K_FOREVER);
+	}
+}
+
+static void ring_rx_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t stamp;
+
+	for (int i = 0; i < BENCH_ITEMS; i++) {
+		spsc_ring_get(&bench_ring, &stamp, K_FOREVER);
+		record_latency(stamp);
+	}
+}
+
+static void run(const char *name, k_thread_entry_t tx, k_thread_entry_t rx)
+{
+	memset(&hist, 0, sizeof(hist));
+
+	k_thread_create(&bench_rx_thread, bench_rx_stack, STACK_SIZE,
+			rx, NULL, NULL, NULL, 5, 0, K_FOREVER);
+	k_thread_create(&bench_tx_thread, bench_tx_stack, STACK_SIZE,
+			tx, NULL, NULL, NULL, 6, 0, K_FOREVER);
+
+	uint32_t start = k_cycle_get_32();
+
+	k_thread_start(&bench_rx_thread);
+	k_thread_start(&bench_tx_thread);
+	k_thread_join(&bench_tx_thread, K_FOREVER);
+	k_thread_join(&bench_rx_thread, K_FOREVER);
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+	uint64_t per_sec = elapsed ? (uint64_t)BENCH_ITEMS *
+		sys_clock_hw_cycles_per_sec() / elapsed : 0;
+
+	printk("%-12s %10llu %8u %8u %8u\n", name,
+	       (unsigned long long)per_sec, lat_hist_percentile(&hist, 500),
+	       lat_hist_percentile(&hist, 990), hist.max);
+}
+
+void bench_spsc(void)
+{
+	printk("\n--- Benchmark: bounded buffer handoff ---\n");
+	printk("%d items, %d slots\n", BENCH_ITEMS, BENCH_SLOTS);
+	printk("%-12s %10s %8s %8s %8s\n", "scheme", "items/s", "p50 cyc",
+	       "p99 cyc", "max cyc");
+
+	k_sem_init(&ref_empty, BENCH_SLOTS, BENCH_SLOTS);
+	k_sem_init(&ref_full, 0, BENCH_SLOTS);
+	k_mutex_init(&ref_mutex);
+	ref_write_idx = 0;
+	ref_read_idx = 0;
+	run("sem+mutex", ref_tx_entry, ref_rx_entry);
+
+	spsc_ring_init(&bench_ring);
+	run("spsc ring", ring_tx_entry, ring_rx_entry);
+	printk("spsc ring sleeps: consumer %u, producer %u\n",
+	       bench_ring.get_waits, bench_ring.put_waits);
+}
@@ -6,8 +6,13 @@
 
 #include <zephyr/kernel.h>
 
+#include "lock_prof.h"
+#include "spsc_ring.h"
+#include "bench.h"
+
 #define STACK_SIZE 1024
 #define BUFFER_SIZE 5
+#define RING_SIZE 4
 
 K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
 K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
@@ -24,6 +29,7 @@ static int read_idx = 0;
 K_SEM_DEFINE(empty_slots, BUFFER_SIZE, BUFFER_SIZE);  /* Available slots */
 K_SEM_DEFINE(full_slots, 0, BUFFER_SIZE);             /* Items in buffer */
 K_MUTEX_DEFINE(buffer_mutex);                          /* Protect buffer access */
+LOCK_PROF_DEFINE(buffer_mutex);
 
 void producer_entry(void *p1, void *p2, void *p3)
 {
@@ -32,14 +38,14 @@ void producer_entry(void *p1, void *p2, void *p3)
 		k_sem_take(&empty_slots, K_FOREVER);
 
 		/* Lock buffer */
-		k_mutex_lock(&buffer_mutex, K_FOREVER);
+		lock_prof_lock(&buffer_mutex_prof, K_FOREVER);
 
 		/* Produce item */
 		buffer[write_idx] = i;
 		printk("[Producer] Produced: %d at index %d\n", i, write_idx);
 		write_idx = (write_idx + 1) % BUFFER_SIZE;
 
-		k_mutex_unlock(&buffer_mutex);
+		lock_prof_unlock(&buffer_mutex_prof);
 
 		/* Signal that buffer has item */
 		k_sem_give(&full_slots);
@@ -58,14 +64,14 @@ void consumer_entry(void *p1, void *p2, void *p3)
 		k_sem_take(&full_slots, K_FOREVER);
 
 		/* Lock buffer */
-		k_mutex_lock(&buffer_mutex, K_FOREVER);
+		lock_prof_lock(&buffer_mutex_prof, K_FOREVER);
 
 		/* Consume item */
 		int item = buffer[read_idx];
 		printk("[Consumer] Consumed: %d from index %d\n", item, read_idx);
 		read_idx = (read_idx + 1) % BUFFER_SIZE;
 
-		k_mutex_unlock(&buffer_mutex);
+		lock_prof_unlock(&buffer_mutex_prof);
 
 		/* Signal that slot is empty */
 		k_sem_give(&empty_slots);
@@ -77,6 +83,38 @@ void consumer_entry(void *p1, void *p2, void *p3)
 	printk("[Consumer] Done consuming\n");
 }
 
+/*
+ * Same hand-off through a lock-free SPSC ring: with one producer and one
+ * consumer no mutex is needed, and a semaphore is only used to sleep.
+ */
+SPSC_RING_DEFINE(item_ring, sizeof(int), RING_SIZE);
+
+void spsc_producer_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 1; i <= 15; i++) {
+		spsc_ring_put(&item_ring, &i, K_FOREVER);
+		printk("[SPSC Producer] Produced: %d\n", i);
+		k_msleep(100);
+	}
+
+	printk("[SPSC Producer] Done producing\n");
+}
+
+void spsc_consumer_entry(void *p1, void *p2, void *p3)
+{
+	int item;
+
+	for (int i = 0; i < 15; i++) {
+		spsc_ring_get(&item_ring, &item, K_FOREVER);
+		printk("[SPSC Consumer] Consumed: %d (%u queued)\n", item,
+		       spsc_ring_num_used_get(&item_ring));
+		k_msleep(200);
+	}
+
+	printk("[SPSC Consumer] Done consuming (producer slept %u times)\n",
+	       item_ring.put_waits);
+}
+
 int main(void)
 {
 	printk("Semaphore Producer-Consumer Example\n");
@@ -96,6 +134,23 @@ int main(void)
 	/* Wait for completion */
 	k_thread_join(&producer_thread, K_FOREVER);
 	k_thread_join(&consumer_thread, K_FOREVER);
+	lock_prof_dump();
+
+	printk("\nLock-free SPSC ring, %d slots\n", RING_SIZE);
+	spsc_ring_init(&item_ring);
+
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			spsc_producer_entry, NULL, NULL, NULL,
+			5, 0, K_NO_WAIT);
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			spsc_consumer_entry, NULL, NULL, NULL,
+			6, 0, K_NO_WAIT);
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	bench_spsc();
+	bench_mpmc();
 
 	printk("Example complete\n");
 
@@ -0,0 +1,145 @@
+/*
+ * Multi-Producer Multi-Consumer Bounded Queue
+ *
+ * Slot i starts with sequence i. A producer that claims position pos
+ * may write the slot once its sequence equals pos, and publishes it by
+ * setting the sequence to pos + 1. A consumer that claims pos may read
+ * once the sequence equals pos + 1, and frees the slot for the next lap
+ * by setting it to pos + capacity. A sequence behind the position means
+ * the queue is full (or empty) as seen by that thread.
+ *
+ * Positions and sequences run freely and are compared modulo 2^32.
+ */
+
+#include <string.h>
+
+#include "mpmc_queue.h"
+
+void mpmc_queue_init(struct mpmc_queue *q)
+{
+	for (uint32_t i = 0; i <= q->mask; i++) {
+		atomic_set(&q->seq[i], i);
+	}
+
+	atomic_set(&q->enqueue_pos, 0);
+	atomic_set(&q->dequeue_pos, 0);
+	atomic_set(&q->consumers_waiting, 0);
+	atomic_set(&q->producers_waiting, 0);
+	atomic_set(&q->collisions, 0);
+	k_sem_init(&q->data_avail, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&q->space_avail, 0, K_SEM_MAX_LIMIT);
+}
+
+/* Claim a position whose slot sequence is @p lag ahead of it */
+static bool claim(struct mpmc_queue *q, atomic_t *pos_var, uint32_t lag,
+		  uint32_t *pos_out)
+{
+	uint32_t pos = atomic_get(pos_var);
+
+	while (true) {
+		uint32_t seq = atomic_get(&q->seq[pos & q->mask]);
+		int32_t dif = (int32_t)(seq - (pos + lag));
+
+		if (dif == 0) {
+			if (atomic_cas(pos_var, pos, pos + 1)) {
+				*pos_out = pos;
+				return true;
+			}
+			atomic_inc(&q->collisions);
+		} else if (dif < 0) {
+			return false;
+		}
+
+		/* Another thread moved on; start from its position */
+		pos = atomic_get(pos_var);
+	}
+}
+
+static bool try_put(struct mpmc_queue *q, const void *item)
+{
+	uint32_t pos;
+
+	if (!claim(q, &q->enqueue_pos, 0, &pos)) {
+		return false;
+	}
+
+	memcpy(q->buf + (pos & q->mask) * q->item_size, item, q->item_size);
+	atomic_set(&q->seq[pos & q->mask], pos + 1);
+
+	if (atomic_get(&q->consumers_waiting) > 0) {
+		k_sem_give(&q->data_avail);
+	}
+	return true;
+}
+
+static bool try_get(struct mpmc_queue *q, void *item)
+{
+	uint32_t pos;
+
+	if (!claim(q, &q->dequeue_pos, 1, &pos)) {
+		return false;
+	}
+
+	memcpy(item, q->buf + (pos & q->mask) * q->item_size, q->item_size);
+	atomic_set(&q->seq[pos & q->mask], pos + q->mask + 1);
+
+	if (atomic_get(&q->producers_waiting) > 0) {
+		k_sem_give(&q->space_avail);
+	}
+	return true;
+}
+
+/*
+ * Blocking paths: the waiter count is raised before the final retry,
+ * and the other side checks it after publishing, so the last item or
+ * slot always produces a wakeup. Surplus semaphore counts only cause an
+ * extra retry.
+ */
+int mpmc_queue_put(struct mpmc_queue *q, const void *item,
+		   k_timeout_t timeout)
+{
+	if (try_put(q, item)) {
+		return 0;
+	}
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret = 0;
+
+	atomic_inc(&q->producers_waiting);
+	while (!try_put(q, item)) {
+		if (k_sem_take(&q->space_avail, sys_timepoint_timeout(end)) != 0) {
+			ret = -EAGAIN;
+			break;
+		}
+	}
+	atomic_dec(&q->producers_waiting);
+
+	return ret;
+}
+
+int mpmc_queue_get(struct mpmc_queue *q, void *item, k_timeout_t timeout)
+{
+	if (try_get(q, item)) {
+		return 0;
+	}
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret = 0;
+
+	atomic_inc(&q->consumers_waiting);
+	while (!try_get(q, item)) {
+		if (k_sem_take(&q->data_avail, sys_timepoint_timeout(end)) != 0) {
+			ret = -EAGAIN;
+			break;
+		}
+	}
+	atomic_dec(&q->consumers_waiting);
+
+	return ret;
+}
@@ -0,0 +1,75 @@
+/*
+ * Multi-Producer Multi-Consumer Bounded Queue
+ *
+ * A bounded FIFO of fixed-size items that any number of threads may put
+ * to and get from. There is no global lock: every slot carries a
+ * sequence number that says whether it is ready to be written or read
+ * for a given lap of the ring, and threads claim positions with a
+ * compare-and-swap on the shared enqueue or dequeue index. Threads only
+ * touch a semaphore when they have to sleep on a full or empty queue.
+ */
+
+#ifndef MPMC_QUEUE_H_
+#define MPMC_QUEUE_H_
+
+#include <zephyr/kernel.h>
+
+struct mpmc_queue {
+	char *buf;
+	atomic_t *seq;		/* per-slot sequence numbers */
+	size_t item_size;
+	uint32_t mask;		/* capacity - 1, capacity is a power of two */
+
+	atomic_t enqueue_pos;
+	atomic_t dequeue_pos;
+
+	/* Sleep support for the blocking paths */
+	atomic_t consumers_waiting;
+	atomic_t producers_waiting;
+	struct k_sem data_avail;
+	struct k_sem space_avail;
+
+	/* Compare-and-swap attempts lost to another thread */
+	atomic_t collisions;
+};
+
+/**
+ * Statically define an MPMC queue of @p capacity items of @p isize
+ * bytes. @p capacity must be a power of two. Call mpmc_queue_init()
+ * before use.
+ */
+#define MPMC_QUEUE_DEFINE(name, isize, capacity)                           \
+	BUILD_ASSERT(IS_POWER_OF_TWO(capacity),                           \
+		     "MPMC queue capacity must be a power of two");        \
+	static char __aligned(4) _mpmc_buf_##name[(isize) * (capacity)];   \
+	static atomic_t _mpmc_seq_##name[capacity];                        \
+	static struct mpmc_queue name = {                                  \
+		.buf = _mpmc_buf_##name,                                   \
+		.seq = _mpmc_seq_##name,                                   \
+		.item_size = (isize),                                      \
+		.mask = (capacity) - 1,                                    \
+	}
+
+/* Reset slot sequence numbers and semaphores; empties the queue */
+void mpmc_queue_init(struct mpmc_queue *q);
+
+/**
+ * Copy one item into the queue.
+ *
+ * @param timeout K_NO_WAIT for the lock-free path, or how long to sleep
+ *        for a free slot.
+ * @retval 0 Item queued.
+ * @retval -EAGAIN Queue full for the whole timeout.
+ */
+int mpmc_queue_put(struct mpmc_queue *q, const void *item,
+		   k_timeout_t timeout);
+
+/**
+ * Copy the oldest available item out of the queue.
+ *
+ * @retval 0 Item returned.
+ * @retval -EAGAIN Queue empty for the whole timeout.
+ */
+int mpmc_queue_get(struct mpmc_queue *q, void *item, k_timeout_t timeout);
+
+#endif /* MPMC_QUEUE_H_ */
@@ -0,0 +1,104 @@
+/*
+ * Single-Producer Single-Consumer Ring
+ *
+ * Indices run freely and wrap at 2^32; the slot is index & mask. The
+ * producer copies the item in before publishing the new head, and the
+ * consumer copies it out before publishing the new tail, so neither
+ * side ever sees a half-written slot.
+ *
+ * A side that must sleep first raises its waiting flag and then checks
+ * the ring again. The other side updates its index before testing the
+ * flag. With sequentially consistent atomics one of the two always
+ * sees the other, so a wakeup cannot be lost. A stale semaphore count
+ * only causes one extra loop.
+ */
+
+#include <string.h>
+
+#include "spsc_ring.h"
+
+void spsc_ring_init(struct spsc_ring *ring)
+{
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	atomic_set(&ring->consumer_waiting, 0);
+	atomic_set(&ring->producer_waiting, 0);
+	k_sem_init(&ring->data_avail, 0, 1);
+	k_sem_init(&ring->space_avail, 0, 1);
+	ring->get_waits = 0;
+	ring->put_waits = 0;
+}
+
+static inline char *slot(struct spsc_ring *ring, uint32_t idx)
+{
+	return ring->buf + (idx & ring->mask) * ring->item_size;
+}
+
+int spsc_ring_put(struct spsc_ring *ring, const void *item,
+		  k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	uint32_t head = atomic_get(&ring->head);
+
+	while (head - (uint32_t)atomic_get(&ring->tail) > ring->mask) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		atomic_set(&ring->producer_waiting, 1);
+		if (head - (uint32_t)atomic_get(&ring->tail) <= ring->mask) {
+			atomic_set(&ring->producer_waiting, 0);
+			break;
+		}
+
+		ring->put_waits++;
+		if (k_sem_take(&ring->space_avail,
+			       sys_timepoint_timeout(end)) != 0) {
+			atomic_set(&ring->producer_waiting, 0);
+			return -EAGAIN;
+		}
+	}
+
+	memcpy(slot(ring, head), item, ring->item_size);
+	atomic_set(&ring->head, head + 1);
+
+	if (atomic_cas(&ring->consumer_waiting, 1, 0)) {
+		k_sem_give(&ring->data_avail);
+	}
+
+	return 0;
+}
+
+int spsc_ring_get(struct spsc_ring *ring, void *item, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	uint32_t tail = atomic_get(&ring->tail);
+
+	while ((uint32_t)atomic_get(&ring->head) == tail) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -EAGAIN;
+		}
+
+		atomic_set(&ring->consumer_waiting, 1);
+		if ((uint32_t)atomic_get(&ring->head) != tail) {
+			atomic_set(&ring->consumer_waiting, 0);
+			break;
+		}
+
+		ring->get_waits++;
+		if (k_sem_take(&ring->data_avail,
+			       sys_timepoint_timeout(end)) != 0) {
+			atomic_set(&ring->consumer_waiting, 0);
+			return -EAGAIN;
+		}
+	}
+
+	memcpy(item, slot(ring, tail), ring->item_size);
+	atomic_set(&ring->tail, tail + 1);
+
+	if (atomic_cas(&ring->producer_waiting, 1, 0)) {
+		k_sem_give(&ring->space_avail);
+	}
+
+	return 0;
+}
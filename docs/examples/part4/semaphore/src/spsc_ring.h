@@ -0,0 +1,79 @@
+/*
+ * Single-Producer Single-Consumer Ring
+ *
+ * A bounded FIFO of fixed-size items for exactly one producer thread
+ * and one consumer thread. Each side owns one index and only reads the
+ * other, so put and get are wait-free and take no lock. A semaphore is
+ * touched only when a side has to sleep on an empty or full ring, and
+ * the other side gives it only if someone is actually waiting.
+ */
+
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+
+#include <zephyr/kernel.h>
+
+struct spsc_ring {
+	char *buf;
+	size_t item_size;
+	uint32_t mask;		/* capacity - 1, capacity is a power of two */
+
+	atomic_t head;		/* items ever written, owned by producer */
+	atomic_t tail;		/* items ever read, owned by consumer */
+
+	/* Sleep support for the blocking paths */
+	atomic_t consumer_waiting;
+	atomic_t producer_waiting;
+	struct k_sem data_avail;
+	struct k_sem space_avail;
+
+	/* Times each side had to sleep (written by that side only) */
+	uint32_t get_waits;
+	uint32_t put_waits;
+};
+
+/**
+ * Statically define an SPSC ring of @p capacity items of @p isize
+ * bytes. @p capacity must be a power of two. Call spsc_ring_init()
+ * before use.
+ */
+#define SPSC_RING_DEFINE(name, isize, capacity)                            \
+	BUILD_ASSERT(IS_POWER_OF_TWO(capacity),                           \
+		     "SPSC ring capacity must be a power of two");         \
+	static char __aligned(4) _spsc_buf_##name[(isize) * (capacity)];   \
+	static struct spsc_ring name = {                                   \
+		.buf = _spsc_buf_##name,                                   \
+		.item_size = (isize),                                      \
+		.mask = (capacity) - 1,                                    \
+	}
+
+/* Initialize the semaphores; also empties the ring and clears stats */
+void spsc_ring_init(struct spsc_ring *ring);
+
+/**
+ * Copy one item into the ring (producer thread only).
+ *
+ * @param timeout K_NO_WAIT for the wait-free path, or how long to
+ *        sleep for a free slot.
+ * @retval 0 Item queued.
+ * @retval -EAGAIN Ring full for the whole timeout.
+ */
+int spsc_ring_put(struct spsc_ring *ring, const void *item,
+		  k_timeout_t timeout);
+
+/**
+ * Copy the oldest item out of the ring (consumer thread only).
+ *
+ * @retval 0 Item returned.
+ * @retval -EAGAIN Ring empty for the whole timeout.
+ */
+int spsc_ring_get(struct spsc_ring *ring, void *item, k_timeout_t timeout);
+
+/* Items currently queued; exact only when called from either side */
+static inline uint32_t spsc_ring_num_used_get(struct spsc_ring *ring)
+{
+	return (uint32_t)atomic_get(&ring->head) -
+	       (uint32_t)atomic_get(&ring->tail);
+}
+
+#endif /* SPSC_RING_H_ */
@@ -0,0 +1,25 @@
+/*
+ * Zbus Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). Meant for native_sim
+ * (west build -b native_sim examples/part4/zbus), where it needs no
+ * hardware; qemu and real boards give more realistic absolute costs.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* Publish and delivery latency over message size, rate and observers */
+void bench_zbus(void);
+
+/* Distinct samples received and bytes copied: plain vs ref subscribers */
+void bench_zbus_ref(void);
+
+/* Listener calls and cycles per sample: per-sample vs batched channel */
+void bench_zbus_batch(void);
+
+/* Publisher latency with a synchronous vs a deferred slow listener */
+void bench_zbus_defer(void);
+
+#endif /* BENCH_H_ */
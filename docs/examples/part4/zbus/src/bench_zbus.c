@@ -0,0 +1,223 @@
+/*
+ * Zbus Channel Benchmark
+ *
+ * Publishes BENCH_MSGS timestamped messages and sweeps one parameter at
+ * a time: message size, publish rate, and the number of listeners and
+ * subscribers, which are attached with runtime observers for each run.
+ * For every run it reports:
+ *
+ *   pub  - time spent in zbus_chan_pub(), which includes running all
+ *          listeners and queueing all subscriber notifications
+ *   lis  - publish to listener call
+ *   sub  - publish to subscriber wakeup, measured on the message the
+ *          subscriber reads, which may already be a newer one
+ *   lost - subscriber notifications dropped because a queue was full
+ *
+ * The publisher never waits, so lost notifications show up as such
+ * instead of as publisher latency. Rates are what k_usleep() achieves
+ * at the configured tick rate, so the actual rate is printed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <string.h>
+
+#include "lat_hist.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_MSGS 200
+#define MAX_OBSERVERS 4
+#define SUB_QUEUE_SIZE 4
+#define SUB_PRIO 6
+#define OBS_TIMEOUT K_MSEC(100)
+
+struct bench_hdr {
+	uint32_t seq;
+	uint32_t stamp;		/* k_cycle_get_32() at publish */
+};
+
+#define BENCH_MSG_DEFINE(size)                                             \
+	struct bench_msg_##size {                                          \
+		struct bench_hdr hdr;                                      \
+		uint8_t payload[size - sizeof(struct bench_hdr)];          \
+	};                                                                 \
+	ZBUS_CHAN_DEFINE(bench_chan_##size, struct bench_msg_##size,       \
+			 NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0))
+
+BENCH_MSG_DEFINE(16);
+BENCH_MSG_DEFINE(64);
+BENCH_MSG_DEFINE(256);
+
+#define MAX_MSG_SIZE sizeof(struct bench_msg_256)
+
+struct run_params {
+	const struct zbus_channel *chan;
+	uint32_t period_us;	/* 0: back to back */
+	size_t listeners;
+	size_t subscribers;
+};
+
+static struct lat_hist pub_hist;
+static struct lat_hist lis_hist;	/* listeners run in the publisher */
+static struct lat_hist sub_hist;
+static struct k_spinlock sub_hist_lock;
+
+static void bench_listener(const struct zbus_channel *chan)
+{
+	const struct bench_hdr *hdr = zbus_chan_const_msg(chan);
+
+	lat_hist_add(&lis_hist, k_cycle_get_32() - hdr->stamp);
+}
+
+ZBUS_LISTENER_DEFINE(bench_lis0, bench_listener);
+ZBUS_LISTENER_DEFINE(bench_lis1, bench_listener);
+ZBUS_LISTENER_DEFINE(bench_lis2, bench_listener);
+ZBUS_LISTENER_DEFINE(bench_lis3, bench_listener);
+
+ZBUS_SUBSCRIBER_DEFINE(bench_sub0, SUB_QUEUE_SIZE);
+ZBUS_SUBSCRIBER_DEFINE(bench_sub1, SUB_QUEUE_SIZE);
+ZBUS_SUBSCRIBER_DEFINE(bench_sub2, SUB_QUEUE_SIZE);
+ZBUS_SUBSCRIBER_DEFINE(bench_sub3, SUB_QUEUE_SIZE);
+
+static const struct zbus_observer *const listeners[MAX_OBSERVERS] = {
+	&bench_lis0, &bench_lis1, &bench_lis2, &bench_lis3,
+};
+
+static const struct zbus_observer *const subscribers[MAX_OBSERVERS] = {
+	&bench_sub0, &bench_sub1, &bench_sub2, &bench_sub3,
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(sub_stacks, MAX_OBSERVERS, STACK_SIZE);
+static struct k_thread sub_threads[MAX_OBSERVERS];
+static uint32_t sub_received[MAX_OBSERVERS];
+static atomic_t publishing;
+
+static void sub_entry(void *p1, void *p2, void *p3)
+{
+	const struct zbus_observer *sub = p1;
+	uint32_t *received = p2;
+	const struct zbus_channel *chan;
+	uint8_t msg[MAX_MSG_SIZE] __aligned(4);	/* read as bench_hdr */
+
+	/* Keep draining until publishing is over and the queue is empty */
+	for (;;) {
+		if (zbus_sub_wait(sub, &chan, K_MSEC(20)) != 0) {
+			if (!atomic_get(&publishing)) {
+				return;
+			}
+			continue;
+		}
+
+		if (zbus_chan_read(chan, msg, K_MSEC(10)) != 0) {
+			continue;
+		}
+
+		uint32_t cycles = k_cycle_get_32() -
+			((const struct bench_hdr *)msg)->stamp;
+		k_spinlock_key_t key = k_spin_lock(&sub_hist_lock);
+
+		lat_hist_add(&sub_hist, cycles);
+		(*received)++;
+		k_spin_unlock(&sub_hist_lock, key);
+	}
+}
+
+static void run(const struct run_params *p)
+{
+	uint8_t msg[MAX_MSG_SIZE] __aligned(4) = { 0 };
+	struct bench_hdr *hdr = (struct bench_hdr *)msg;
+	uint32_t delivered = 0;
+	uint32_t received = 0;
+
+	memset(&pub_hist, 0, sizeof(pub_hist));
+	memset(&lis_hist, 0, sizeof(lis_hist));
+	memset(&sub_hist, 0, sizeof(sub_hist));
+
+	for (size_t i = 0; i < p->listeners; i++) {
+		zbus_chan_add_obs(p->chan, listeners[i], OBS_TIMEOUT);
+	}
+
+	atomic_set(&publishing, 1);
+	for (size_t i = 0; i < p->subscribers; i++) {
+		sub_received[i] = 0;
+		zbus_chan_add_obs(p->chan, subscribers[i], OBS_TIMEOUT);
+		k_thread_create(&sub_threads[i], sub_stacks[i], STACK_SIZE,
+				sub_entry, (void *)subscribers[i],
+				&sub_received[i], NULL, SUB_PRIO, 0, K_NO_WAIT);
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t seq = 0; seq < BENCH_MSGS; seq++) {
+		hdr->seq = seq;
+		hdr->stamp = k_cycle_get_32();
+
+		int ret = zbus_chan_pub(p->chan, msg, K_NO_WAIT);
+
+		lat_hist_add(&pub_hist, k_cycle_get_32() - hdr->stamp);
+
+		/* -EBUSY: channel locked, nobody was notified */
+		if (ret != -EBUSY) {
+			delivered++;
+		}
+
+		if (p->period_us != 0) {
+			k_usleep(p->period_us);
+		}
+	}
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+
+	atomic_set(&publishing, 0);
+	for (size_t i = 0; i < p->subscribers; i++) {
+		k_thread_join(&sub_threads[i], K_FOREVER);
+		zbus_chan_rm_obs(p->chan, subscribers[i], OBS_TIMEOUT);
+		received += sub_received[i];
+	}
+	for (size_t i = 0; i < p->listeners; i++) {
+		zbus_chan_rm_obs(p->chan, listeners[i], OBS_TIMEOUT);
+	}
+
+	uint32_t rate = elapsed ? (uint32_t)((uint64_t)BENCH_MSGS *
+		sys_clock_hw_cycles_per_sec() / elapsed) : 0;
+	uint32_t expected = delivered * p->subscribers;
+
+	printk("%5zu %7u %2zu %2zu %8u %8u %8u %8u %8u %8u %6u\n",
+	       zbus_chan_msg_size(p->chan), rate, p->listeners,
+	       p->subscribers, lat_hist_percentile(&pub_hist, 500),
+	       lat_hist_percentile(&pub_hist, 990),
+	       lat_hist_percentile(&lis_hist, 500),
+	       lat_hist_percentile(&lis_hist, 990),
+	       lat_hist_percentile(&sub_hist, 500),
+	       lat_hist_percentile(&sub_hist, 990),
+	       expected > received ? expected - received : 0);
+}
+
+static const struct run_params runs[] = {
+	/* Message size at 1 kHz, one observer of each kind */
+	{ &bench_chan_16, 1000, 1, 1 },
+	{ &bench_chan_64, 1000, 1, 1 },
+	{ &bench_chan_256, 1000, 1, 1 },
+	/* Publish rate */
+	{ &bench_chan_16, 0, 1, 1 },
+	{ &bench_chan_16, 10000, 1, 1 },
+	/* Fan-out */
+	{ &bench_chan_16, 1000, 4, 0 },
+	{ &bench_chan_16, 1000, 0, 4 },
+	{ &bench_chan_16, 1000, 4, 4 },
+};
+
+void bench_zbus(void)
+{
+	printk("\n--- Benchmark: zbus publish and delivery ---\n");
+	printk("%d messages per run, subscriber queues of %d, cycles\n",
+	       BENCH_MSGS, SUB_QUEUE_SIZE);
+	printk("%5s %7s %2s %2s %8s %8s %8s %8s %8s %8s %6s\n", "size",
+	       "msg/s", "L", "S", "pub p50", "pub p99", "lis p50",
+	       "lis p99", "sub p50", "sub p99", "lost");
+
+	for (size_t i = 0; i < ARRAY_SIZE(runs); i++) {
+		run(&runs[i]);
+	}
+}
@@ -0,0 +1,128 @@
+/*
+ * Batched Channel Benchmark
+ *
+ * Publishes 1000 samples back to back, first one per zbus_chan_pub()
+ * on a plain channel and then through batch channels of 10 and 50.
+ * Each listener does what display_listener does once per call (format
+ * a line, here into a buffer instead of the console) and folds each
+ * sample into a running sum. The table shows listener calls and the
+ * listener and publisher cycles spent per sample.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "zbus_batch.h"
+#include "bench.h"
+
+#define BENCH_SAMPLES 1000
+
+struct bench_sample {
+	uint32_t seq;
+	int32_t value;
+};
+
+static uint32_t listener_calls;
+static uint32_t listener_cycles;
+static int64_t value_sum;
+static char line[64];
+
+static void display_work(uint32_t count)
+{
+	snprintk(line, sizeof(line), "[Display] %u samples, sum %lld", count,
+		 (long long)value_sum);
+}
+
+static void sample_listener(const struct zbus_channel *chan)
+{
+	uint32_t start = k_cycle_get_32();
+	const struct bench_sample *sample = zbus_chan_const_msg(chan);
+
+	value_sum += sample->value;
+	display_work(1);
+
+	listener_calls++;
+	listener_cycles += k_cycle_get_32() - start;
+}
+
+ZBUS_LISTENER_DEFINE(sample_lis, sample_listener);
+
+ZBUS_CHAN_DEFINE(single_chan, struct bench_sample, NULL, NULL,
+		 ZBUS_OBSERVERS(sample_lis), ZBUS_MSG_INIT(0));
+
+ZBUS_BATCH_DEFINE(bench_batch10, struct bench_sample, 10, 50);
+ZBUS_BATCH_DEFINE(bench_batch50, struct bench_sample, 50, 50);
+
+/* Same work per call as sample_listener, over the whole array */
+#define BATCH_LISTENER_DEFINE(_batch)                                      \
+	static void _batch##_listener(const struct zbus_channel *chan)     \
+	{                                                                  \
+		uint32_t start = k_cycle_get_32();                         \
+		const struct _batch##_msg *msg =                           \
+			zbus_chan_const_msg(chan);                         \
+                                                                           \
+		for (uint32_t i = 0; i < msg->count; i++) {                \
+			value_sum += msg->items[i].value;                  \
+		}                                                          \
+		display_work(msg->count);                                  \
+                                                                           \
+		listener_calls++;                                          \
+		listener_cycles += k_cycle_get_32() - start;               \
+	}                                                                  \
+	ZBUS_LISTENER_DEFINE(_batch##_lis, _batch##_listener);             \
+	ZBUS_CHAN_ADD_OBS(_batch##_chan, _batch##_lis, 0)
+
+BATCH_LISTENER_DEFINE(bench_batch10);
+BATCH_LISTENER_DEFINE(bench_batch50);
+
+static void reset(void)
+{
+	listener_calls = 0;
+	listener_cycles = 0;
+	value_sum = 0;
+}
+
+static void report(const char *scheme, uint32_t batch, uint32_t pub_cycles)
+{
+	printk("%-8s %5u %6u %10u %10u\n", scheme, batch, listener_calls,
+	       listener_cycles / BENCH_SAMPLES, pub_cycles / BENCH_SAMPLES);
+}
+
+static void run_batch(const char *scheme, struct zbus_batch *batch)
+{
+	uint32_t start;
+
+	reset();
+	start = k_cycle_get_32();
+
+	for (uint32_t seq = 0; seq < BENCH_SAMPLES; seq++) {
+		struct bench_sample sample = { .seq = seq, .value = seq % 100 };
+
+		zbus_batch_add(batch, &sample, K_MSEC(100));
+	}
+	zbus_batch_flush(batch, K_MSEC(100));
+
+	report(scheme, batch->capacity, k_cycle_get_32() - start);
+}
+
+void bench_zbus_batch(void)
+{
+	uint32_t start;
+
+	printk("\n--- Benchmark: per-sample vs batched publishing ---\n");
+	printk("%d samples back to back, cycles per sample\n", BENCH_SAMPLES);
+	printk("%-8s %5s %6s %10s %10s\n", "scheme", "batch", "calls",
+	       "listener", "publish");
+
+	reset();
+	start = k_cycle_get_32();
+	for (uint32_t seq = 0; seq < BENCH_SAMPLES; seq++) {
+		struct bench_sample sample = { .seq = seq, .value = seq % 100 };
+
+		zbus_chan_pub(&single_chan, &sample, K_MSEC(100));
+	}
+	report("single", 1, k_cycle_get_32() - start);
+
+	run_batch("batch", &bench_batch10);
+	run_batch("batch", &bench_batch50);
+}
@@ -0,0 +1,138 @@
+/*
+ * Deferred Listener Benchmark
+ *
+ * Publishes BENCH_MSGS samples to a channel whose only observer does
+ * the display listener's work, once as a plain listener and once as a
+ * deferred one on a lower-priority workqueue. Here that work is
+ * formatting the line into a buffer plus CONSOLE_US of busy waiting,
+ * standing in for pushing it out of a UART. For every run it reports:
+ *
+ *   pub  - time spent in zbus_chan_pub(), which the publisher pays
+ *   done - publish to the display work having finished
+ *   drop - samples the deferred listener had no buffer for
+ *
+ * The 1 kHz runs leave the workqueue time to catch up between samples;
+ * the back-to-back run shows what happens when it cannot.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lat_hist.h"
+#include "zbus_defer.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_MSGS 200
+#define CONSOLE_US 200		/* console cost per line */
+#define DEFER_DEPTH 8
+#define DEFER_PRIO 8
+
+struct bench_sample {
+	uint32_t seq;
+	uint32_t stamp;		/* k_cycle_get_32() at publish */
+	int32_t temperature;
+	int32_t humidity;
+};
+
+static struct lat_hist pub_hist;
+static struct lat_hist done_hist;
+static char line[64];
+
+K_THREAD_STACK_DEFINE(defer_stack, STACK_SIZE);
+static struct k_work_q defer_q;
+
+static void display_work(const struct bench_sample *sample)
+{
+	snprintk(line, sizeof(line), "[Display] Temp: %d.%03d C, Hum: %d @ %u",
+		 sample->temperature / 1000, abs(sample->temperature % 1000),
+		 sample->humidity / 1000, sample->seq);
+	k_busy_wait(CONSOLE_US);
+
+	lat_hist_add(&done_hist, k_cycle_get_32() - sample->stamp);
+}
+
+static void sync_listener(const struct zbus_channel *chan)
+{
+	display_work(zbus_chan_const_msg(chan));
+}
+
+static void deferred_listener(const struct zbus_channel *chan,
+			      const void *msg)
+{
+	display_work(msg);
+}
+
+ZBUS_LISTENER_DEFINE(bench_sync_lis, sync_listener);
+ZBUS_DEFERRED_LISTENER_DEFINE(bench_defer_lis, deferred_listener,
+			      struct bench_sample, DEFER_DEPTH, &defer_q);
+
+ZBUS_CHAN_DEFINE(sync_chan, struct bench_sample, NULL, NULL,
+		 ZBUS_OBSERVERS(bench_sync_lis), ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(defer_chan, struct bench_sample, NULL, NULL,
+		 ZBUS_OBSERVERS(bench_defer_lis), ZBUS_MSG_INIT(0));
+
+static void run(const char *mode, const struct zbus_channel *chan,
+		uint32_t period_us)
+{
+	struct bench_sample sample = { 0 };
+	struct zbus_defer *defer = &bench_defer_lis_defer;
+	atomic_val_t dropped = atomic_get(&defer->dropped);
+
+	memset(&pub_hist, 0, sizeof(pub_hist));
+	memset(&done_hist, 0, sizeof(done_hist));
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t seq = 0; seq < BENCH_MSGS; seq++) {
+		sample.seq = seq;
+		sample.temperature = 22000 + (int32_t)(seq % 1000);
+		sample.humidity = 45000;
+		sample.stamp = k_cycle_get_32();
+
+		zbus_chan_pub(chan, &sample, K_MSEC(100));
+		lat_hist_add(&pub_hist, k_cycle_get_32() - sample.stamp);
+
+		if (period_us != 0) {
+			k_usleep(period_us);
+		}
+	}
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+
+	/* Let the deferred handler finish before reading done_hist */
+	k_work_queue_drain(&defer_q, false);
+
+	uint32_t rate = elapsed ? (uint32_t)((uint64_t)BENCH_MSGS *
+		sys_clock_hw_cycles_per_sec() / elapsed) : 0;
+
+	printk("%-8s %6u %8u %8u %8u %8u %8u %5u\n", mode, rate,
+	       lat_hist_percentile(&pub_hist, 500),
+	       lat_hist_percentile(&pub_hist, 990), pub_hist.max,
+	       lat_hist_percentile(&done_hist, 500),
+	       lat_hist_percentile(&done_hist, 990),
+	       (uint32_t)(atomic_get(&defer->dropped) - dropped));
+}
+
+void bench_zbus_defer(void)
+{
+	struct k_work_queue_config cfg = { .name = "bench_defer" };
+
+	printk("\n--- Benchmark: synchronous vs deferred listener ---\n");
+	printk("%d samples per run, %d us display work, %d buffers, cycles\n",
+	       BENCH_MSGS, CONSOLE_US, DEFER_DEPTH);
+	printk("%-8s %6s %8s %8s %8s %8s %8s %5s\n", "mode", "msg/s",
+	       "pub p50", "pub p99", "pub max", "done p50", "done p99",
+	       "drop");
+
+	k_work_queue_init(&defer_q);
+	k_work_queue_start(&defer_q, defer_stack,
+			   K_THREAD_STACK_SIZEOF(defer_stack), DEFER_PRIO, &cfg);
+
+	run("sync", &sync_chan, 1000);
+	run("deferred", &defer_chan, 1000);
+	run("sync", &sync_chan, 0);
+	run("deferred", &defer_chan, 0);
+}
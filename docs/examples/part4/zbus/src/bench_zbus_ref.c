@@ -0,0 +1,182 @@
+/*
+ * Ref Subscriber Benchmark
+ *
+ * Publishes numbered samples in bursts, faster than the subscribers
+ * process them, to two plain subscribers (zbus_sub_wait() plus
+ * zbus_chan_read()) and two ref subscribers on the same channel. A
+ * plain subscriber reads whatever the channel holds when it gets to a
+ * notification, so during a burst it sees the newest sample several
+ * times and never sees the ones in between. A ref subscriber gets each
+ * published sample. The table shows how many distinct samples each
+ * kind received and how many message bytes were copied to get them.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <string.h>
+
+#include "zbus_ref.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_SAMPLES 1000
+#define BURST 4			/* publishes per scheduler tick */
+#define SUBS_PER_KIND 2
+#define SUB_QUEUE_SIZE 8
+#define SUB_PRIO 6
+#define PROCESS_US 100
+
+struct ref_sample {
+	uint32_t seq;
+	uint32_t stamp;
+	int32_t values[6];
+};
+
+ZBUS_REF_CHAN_DEFINE(ref_bench_pool, struct ref_sample, 16);
+
+ZBUS_CHAN_DEFINE(ref_bench_chan, struct ref_sample, NULL, &ref_bench_pool,
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+ZBUS_SUBSCRIBER_DEFINE(copy_sub0, SUB_QUEUE_SIZE);
+ZBUS_SUBSCRIBER_DEFINE(copy_sub1, SUB_QUEUE_SIZE);
+ZBUS_REF_SUB_DEFINE(ref_sub0, SUB_QUEUE_SIZE);
+ZBUS_REF_SUB_DEFINE(ref_sub1, SUB_QUEUE_SIZE);
+
+ZBUS_CHAN_ADD_OBS(ref_bench_chan, copy_sub0, 0);
+ZBUS_CHAN_ADD_OBS(ref_bench_chan, copy_sub1, 1);
+ZBUS_CHAN_ADD_OBS(ref_bench_chan, zbus_ref_lis, 2);
+
+struct sub_result {
+	uint32_t seen[DIV_ROUND_UP(BENCH_SAMPLES, 32)];
+	uint32_t unique;
+	uint32_t reads;		/* zbus_chan_read() copies */
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(ref_bench_stacks, 2 * SUBS_PER_KIND, STACK_SIZE);
+static struct k_thread ref_bench_threads[2 * SUBS_PER_KIND];
+static struct sub_result results[2 * SUBS_PER_KIND];
+static atomic_t publishing;
+
+static void mark_seen(struct sub_result *res, uint32_t seq)
+{
+	if (seq >= BENCH_SAMPLES) {
+		return;
+	}
+	if ((res->seen[seq / 32] & BIT(seq % 32)) == 0) {
+		res->seen[seq / 32] |= BIT(seq % 32);
+		res->unique++;
+	}
+}
+
+static void copy_sub_entry(void *p1, void *p2, void *p3)
+{
+	const struct zbus_observer *sub = p1;
+	struct sub_result *res = p2;
+	const struct zbus_channel *chan;
+	struct ref_sample sample;
+
+	for (;;) {
+		if (zbus_sub_wait(sub, &chan, K_MSEC(20)) != 0) {
+			if (!atomic_get(&publishing)) {
+				return;
+			}
+			continue;
+		}
+
+		if (zbus_chan_read(chan, &sample, K_MSEC(10)) == 0) {
+			res->reads++;
+			mark_seen(res, sample.seq);
+			k_busy_wait(PROCESS_US);
+		}
+	}
+}
+
+static void ref_sub_entry(void *p1, void *p2, void *p3)
+{
+	struct zbus_ref_sub *sub = p1;
+	struct sub_result *res = p2;
+	struct zbus_ref_buf *buf;
+
+	for (;;) {
+		if (zbus_ref_sub_wait(sub, &buf, K_MSEC(20)) != 0) {
+			if (!atomic_get(&publishing)) {
+				return;
+			}
+			continue;
+		}
+
+		const struct ref_sample *sample = zbus_ref_msg(buf);
+
+		mark_seen(res, sample->seq);
+		k_busy_wait(PROCESS_US);
+		zbus_ref_unref(buf);
+	}
+}
+
+static void report(const char *kind, size_t idx, uint32_t copies)
+{
+	const struct sub_result *res = &results[idx];
+	uint32_t lost = BENCH_SAMPLES - res->unique;
+	uint32_t loss_x10 = lost * 1000 / BENCH_SAMPLES;
+
+	printk("%-6s %zu %8u %8u %5u.%u%% %12zu\n", kind,
+	       idx % SUBS_PER_KIND, res->unique, lost, loss_x10 / 10,
+	       loss_x10 % 10, (size_t)copies * sizeof(struct ref_sample));
+}
+
+void bench_zbus_ref(void)
+{
+	struct ref_sample sample = { 0 };
+	const struct zbus_observer *const copy_subs[] = { &copy_sub0, &copy_sub1 };
+	struct zbus_ref_sub *const ref_subs[] = { &ref_sub0, &ref_sub1 };
+
+	printk("\n--- Benchmark: plain vs ref subscribers ---\n");
+	printk("%d samples in bursts of %d, %d us processing each\n",
+	       BENCH_SAMPLES, BURST, PROCESS_US);
+
+	memset(results, 0, sizeof(results));
+	atomic_set(&publishing, 1);
+
+	for (size_t i = 0; i < SUBS_PER_KIND; i++) {
+		zbus_ref_attach(&ref_bench_pool, ref_subs[i]);
+
+		k_thread_create(&ref_bench_threads[i], ref_bench_stacks[i],
+				STACK_SIZE, copy_sub_entry,
+				(void *)copy_subs[i], &results[i], NULL,
+				SUB_PRIO, 0, K_NO_WAIT);
+		k_thread_create(&ref_bench_threads[SUBS_PER_KIND + i],
+				ref_bench_stacks[SUBS_PER_KIND + i],
+				STACK_SIZE, ref_sub_entry, ref_subs[i],
+				&results[SUBS_PER_KIND + i], NULL, SUB_PRIO, 0,
+				K_NO_WAIT);
+	}
+
+	for (uint32_t seq = 0; seq < BENCH_SAMPLES; seq++) {
+		sample.seq = seq;
+		sample.stamp = k_cycle_get_32();
+		zbus_chan_pub(&ref_bench_chan, &sample, K_NO_WAIT);
+
+		if ((seq + 1) % BURST == 0) {
+			k_sleep(K_TICKS(1));
+		}
+	}
+
+	atomic_set(&publishing, 0);
+	for (size_t i = 0; i < ARRAY_SIZE(ref_bench_threads); i++) {
+		k_thread_join(&ref_bench_threads[i], K_FOREVER);
+	}
+
+	printk("%-6s %s %8s %8s %7s %12s\n", "kind", "#", "samples", "lost",
+	       "loss", "bytes copied");
+	for (size_t i = 0; i < SUBS_PER_KIND; i++) {
+		report("plain", i, results[i].reads);
+	}
+	/* One copy per publish, shared by all ref subscribers */
+	for (size_t i = SUBS_PER_KIND; i < ARRAY_SIZE(results); i++) {
+		report("ref", i, (uint32_t)atomic_get(&ref_bench_pool.copies));
+	}
+	printk("ref: %u pool misses, %u + %u queue drops\n",
+	       (uint32_t)atomic_get(&ref_bench_pool.alloc_fails),
+	       (uint32_t)atomic_get(&ref_sub0.dropped),
+	       (uint32_t)atomic_get(&ref_sub1.dropped));
+}
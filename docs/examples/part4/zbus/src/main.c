@@ -8,6 +8,11 @@
 #include <zephyr/zbus/zbus.h>
 #include <zephyr/random/random.h>
 
+#include "zbus_ref.h"
+#include "zbus_batch.h"
+#include "zbus_defer.h"
+#include "bench.h"
+
 /* Message structure */
 struct sensor_data {
 	int32_t temperature;  /* milli-Celsius */
@@ -15,18 +20,31 @@ struct sensor_data {
 	uint32_t timestamp;
 };
 
+/* Buffers that carry each published sample to the logger */
+ZBUS_REF_CHAN_DEFINE(sensor_ref, struct sensor_data, 8);
+
 /* Define channel */
 ZBUS_CHAN_DEFINE(sensor_chan,
 		 struct sensor_data,
-		 NULL,  /* User data */
 		 NULL,  /* Validator */
+		 &sensor_ref,  /* User data */
 		 ZBUS_OBSERVERS_EMPTY,
 		 ZBUS_MSG_INIT(.temperature = 0, .humidity = 0, .timestamp = 0));
 
-/* Listener - called synchronously in publisher context */
-void display_listener(const struct zbus_channel *chan)
+/* Display workqueue - runs deferred listeners off the publish path */
+#define DISPLAY_STACK_SIZE 1024
+#define DISPLAY_PRIORITY 8
+
+K_THREAD_STACK_DEFINE(display_stack, DISPLAY_STACK_SIZE);
+static struct k_work_q display_q;
+
+/*
+ * Deferred listener - the publisher only copies the sample; the slow
+ * printk formatting runs later on display_q with that copy
+ */
+static void display_listener(const struct zbus_channel *chan, const void *data)
 {
-	const struct sensor_data *msg = zbus_chan_const_msg(chan);
+	const struct sensor_data *msg = data;
 
 	printk("[Display] Temp: %d.%03d C, Humidity: %d.%01d%% @ %u\n",
 	       msg->temperature / 1000, abs(msg->temperature % 1000),
@@ -34,25 +52,29 @@ void display_listener(const struct zbus_channel *chan)
 	       msg->timestamp);
 }
 
-ZBUS_LISTENER_DEFINE(display_lis, display_listener);
+ZBUS_DEFERRED_LISTENER_DEFINE(display_lis, display_listener,
+			      struct sensor_data, 4, &display_q);
 
-/* Subscriber - has own message queue */
-ZBUS_SUBSCRIBER_DEFINE(logger_sub, 8);
+/*
+ * Subscriber - has own message queue. It receives the published sample
+ * itself, so a newer publish cannot replace it before it is logged.
+ */
+ZBUS_REF_SUB_DEFINE(logger_ref, 8);
 
 /* Subscriber thread */
 void logger_thread_entry(void *p1, void *p2, void *p3)
 {
-	const struct zbus_channel *chan;
+	struct zbus_ref_buf *buf;
 
 	printk("[Logger] Thread started\n");
 
 	while (1) {
-		if (zbus_sub_wait(&logger_sub, &chan, K_FOREVER) == 0) {
-			struct sensor_data msg;
-			zbus_chan_read(chan, &msg, K_NO_WAIT);
+		if (zbus_ref_sub_wait(&logger_ref, &buf, K_FOREVER) == 0) {
+			const struct sensor_data *msg = zbus_ref_msg(buf);
 
 			printk("[Logger] Logged: temp=%d, hum=%d, ts=%u\n",
-			       msg.temperature, msg.humidity, msg.timestamp);
+			       msg->temperature, msg->humidity, msg->timestamp);
+			zbus_ref_unref(buf);
 		}
 	}
 }
@@ -61,7 +83,28 @@ K_THREAD_DEFINE(logger_tid, 1024, logger_thread_entry, NULL, NULL, NULL, 7, 0, 0
 
 /* Add observers to channel */
 ZBUS_CHAN_ADD_OBS(sensor_chan, display_lis, 0);
-ZBUS_CHAN_ADD_OBS(sensor_chan, logger_sub, 1);
+ZBUS_CHAN_ADD_OBS(sensor_chan, zbus_ref_lis, 1);
+
+/* Trend - runs once per batch of samples instead of once per sample */
+ZBUS_BATCH_DEFINE(sensor_batch, struct sensor_data, 5, 20000);
+
+void trend_listener(const struct zbus_channel *chan)
+{
+	const struct sensor_batch_msg *msg = zbus_chan_const_msg(chan);
+	int32_t sum = 0;
+
+	for (uint32_t i = 0; i < msg->count; i++) {
+		sum += msg->items[i].temperature;
+	}
+
+	if (msg->count > 0) {
+		printk("[Trend] %u samples, avg temp: %d mC\n", msg->count,
+		       sum / (int32_t)msg->count);
+	}
+}
+
+ZBUS_LISTENER_DEFINE(trend_lis, trend_listener);
+ZBUS_CHAN_ADD_OBS(sensor_batch_chan, trend_lis, 0);
 
 /* Simulated sensor reading using hardware RNG */
 static int32_t read_temperature(void)
@@ -84,6 +127,15 @@ int main(void)
 
 	printk("Zbus Publish-Subscribe Example\n");
 
+	struct k_work_queue_config display_cfg = { .name = "display_q" };
+
+	k_work_queue_init(&display_q);
+	k_work_queue_start(&display_q, display_stack,
+			   K_THREAD_STACK_SIZEOF(display_stack), DISPLAY_PRIORITY,
+			   &display_cfg);
+
+	zbus_ref_attach(&sensor_ref, &logger_ref);
+
 	/* Publish sensor data periodically */
 	for (int i = 0; i < 10; i++) {
 		msg.temperature = read_temperature();
@@ -97,9 +149,16 @@ int main(void)
 			printk("[Publisher] Publish failed: %d\n", ret);
 		}
 
+		zbus_batch_add(&sensor_batch, &msg, K_MSEC(100));
+
 		k_sleep(K_SECONDS(2));
 	}
 
+	bench_zbus();
+	bench_zbus_ref();
+	bench_zbus_batch();
+	bench_zbus_defer();
+
 	printk("\nExample complete\n");
 
 	return 0;
@@ -0,0 +1,98 @@
+/*
+ * Batched Zbus Channel
+ *
+ * Items go into a staging copy of the message while the batch mutex is
+ * held. A full or timed-out batch is published with zbus_chan_pub()
+ * straight from staging, still under the batch mutex, so the next batch
+ * cannot reach the channel before every observer has been given this
+ * one. Observers therefore run with the batch locked and must not add
+ * to the batch they observe.
+ */
+
+#include <string.h>
+
+#include "zbus_batch.h"
+
+/* Publish staging and start a new batch; call with the batch locked */
+static int publish_locked(struct zbus_batch *batch, k_timeout_t timeout)
+{
+	int ret = zbus_chan_pub(batch->chan, batch->staging, timeout);
+
+	if (ret != 0) {
+		batch->pub_errors++;
+		return ret;
+	}
+
+	*batch->count = 0;
+	batch->batches++;
+	k_work_cancel_delayable(&batch->flush_work);
+
+	return 0;
+}
+
+int zbus_batch_add(struct zbus_batch *batch, const void *item,
+		   k_timeout_t timeout)
+{
+	int ret = 0;
+
+	if (k_mutex_lock(&batch->lock, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	memcpy(batch->items + *batch->count * batch->item_size, item,
+	       batch->item_size);
+	(*batch->count)++;
+	batch->samples++;
+
+	if (*batch->count == batch->capacity) {
+		ret = publish_locked(batch, timeout);
+		if (ret != 0) {
+			/* Keep the batch consistent: take the item back */
+			(*batch->count)--;
+			batch->samples--;
+		}
+	} else if (*batch->count == 1) {
+		k_work_schedule(&batch->flush_work,
+				K_MSEC(batch->max_wait_ms));
+	}
+
+	k_mutex_unlock(&batch->lock);
+
+	return ret == 0 ? 0 : -EAGAIN;
+}
+
+int zbus_batch_flush(struct zbus_batch *batch, k_timeout_t timeout)
+{
+	int ret;
+
+	if (k_mutex_lock(&batch->lock, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	if (*batch->count == 0) {
+		k_mutex_unlock(&batch->lock);
+		return 0;
+	}
+
+	ret = publish_locked(batch, timeout);
+	k_mutex_unlock(&batch->lock);
+
+	return ret == 0 ? 0 : -EAGAIN;
+}
+
+static void flush_handler(struct k_work *work)
+{
+	struct zbus_batch *batch = CONTAINER_OF(k_work_delayable_from_work(work),
+						struct zbus_batch, flush_work);
+
+	/* Channel stayed busy: try again after another wait */
+	if (zbus_batch_flush(batch, K_MSEC(100)) != 0) {
+		k_work_schedule(&batch->flush_work, K_MSEC(batch->max_wait_ms));
+	}
+}
+
+void zbus_batch_init(struct zbus_batch *batch)
+{
+	k_mutex_init(&batch->lock);
+	k_work_init_delayable(&batch->flush_work, flush_handler);
+}
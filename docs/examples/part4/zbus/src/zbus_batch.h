@@ -0,0 +1,103 @@
+/*
+ * Batched Zbus Channel
+ *
+ * For high-rate sources whose observers do not need every sample the
+ * moment it arrives. Samples are collected until the batch is full or
+ * the oldest one has waited long enough, then published once as a
+ * count plus a contiguous array, so each observer runs once per batch
+ * instead of once per sample:
+ *
+ *   ZBUS_BATCH_DEFINE(sensor_batch, struct sensor_data, 10, 50);
+ *   ZBUS_CHAN_ADD_OBS(sensor_batch_chan, trend_lis, 0);
+ *
+ *   zbus_batch_add(&sensor_batch, &sample, K_MSEC(100));
+ *
+ *   void trend_listener(const struct zbus_channel *chan)
+ *   {
+ *           const struct sensor_batch_msg *msg = zbus_chan_const_msg(chan);
+ *
+ *           for (uint32_t i = 0; i < msg->count; i++) {
+ *                   ... msg->items[i] ...
+ *           }
+ *   }
+ *
+ * Batches closed by the time limit are published from the system
+ * workqueue, so their observers run there. Adding is for threads only.
+ */
+
+#ifndef ZBUS_BATCH_H_
+#define ZBUS_BATCH_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+struct zbus_batch {
+	const struct zbus_channel *chan;
+	void *staging;		/* a <name>_msg being filled */
+	uint32_t *count;	/* staging's count field */
+	uint8_t *items;		/* staging's items array */
+	size_t item_size;
+	uint32_t capacity;
+	uint32_t max_wait_ms;
+
+	struct k_mutex lock;
+	struct k_work_delayable flush_work;
+
+	/* Statistics */
+	uint32_t samples;
+	uint32_t batches;
+	uint32_t pub_errors;
+};
+
+/* Set up the lock and timer; ZBUS_BATCH_DEFINE does this at boot */
+void zbus_batch_init(struct zbus_batch *batch);
+
+/*
+ * Define batch @p _name of up to @p _n items of @p _type, published at
+ * the latest @p _wait_ms after its first item. Also defines the message
+ * type struct <_name>_msg and the channel <_name>_chan.
+ */
+#define ZBUS_BATCH_DEFINE(_name, _type, _n, _wait_ms)                      \
+	struct _name##_msg {                                               \
+		uint32_t count;                                            \
+		_type items[_n];                                           \
+	};                                                                 \
+	ZBUS_CHAN_DEFINE(_name##_chan, struct _name##_msg, NULL, NULL,     \
+			 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));          \
+	static struct _name##_msg _name##_staging;                         \
+	struct zbus_batch _name = {                                        \
+		.chan = &_name##_chan,                                     \
+		.staging = &_name##_staging,                               \
+		.count = &_name##_staging.count,                           \
+		.items = (uint8_t *)_name##_staging.items,                 \
+		.item_size = sizeof(_type),                                \
+		.capacity = (_n),                                          \
+		.max_wait_ms = (_wait_ms),                                 \
+	};                                                                 \
+	static int _name##_init(void)                                      \
+	{                                                                  \
+		zbus_batch_init(&_name);                                   \
+		return 0;                                                  \
+	}                                                                  \
+	SYS_INIT(_name##_init, APPLICATION,                                \
+		 CONFIG_APPLICATION_INIT_PRIORITY)
+
+/**
+ * Add one item, publishing the batch if this fills it.
+ *
+ * @retval 0 Item added.
+ * @retval -EAGAIN The batch was busy, or its publish did not finish,
+ *                 within @p timeout; the item is not added.
+ */
+int zbus_batch_add(struct zbus_batch *batch, const void *item,
+		   k_timeout_t timeout);
+
+/**
+ * Publish whatever the batch holds now.
+ *
+ * @retval 0 Published, or nothing to publish.
+ * @retval -EAGAIN The batch or its channel was busy for @p timeout.
+ */
+int zbus_batch_flush(struct zbus_batch *batch, k_timeout_t timeout);
+
+#endif /* ZBUS_BATCH_H_ */
@@ -0,0 +1,70 @@
+/*
+ * Deferred Zbus Listeners
+ *
+ * The enqueue side runs in the publisher's context while the channel
+ * is locked, so the message it copies is exactly the one published. It
+ * never waits: the buffer comes from the slab with K_NO_WAIT and the
+ * pending list is only held for a list operation. One work item drains
+ * the whole list, so a burst of publishes costs one submit per run of
+ * the workqueue rather than one per message.
+ */
+
+#include <string.h>
+
+#include "zbus_defer.h"
+
+static void work_handler(struct k_work *work)
+{
+	struct zbus_defer *defer = CONTAINER_OF(work, struct zbus_defer, work);
+	struct zbus_defer_buf *buf;
+	sys_snode_t *node;
+	k_spinlock_key_t key;
+
+	while (true) {
+		key = k_spin_lock(&defer->lock);
+		node = sys_slist_get(&defer->pending);
+		k_spin_unlock(&defer->lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		buf = CONTAINER_OF(node, struct zbus_defer_buf, node);
+		defer->handler(buf->chan, buf->msg);
+		atomic_inc(&defer->handled);
+		k_mem_slab_free(defer->slab, buf);
+	}
+}
+
+void zbus_defer_init(struct zbus_defer *defer)
+{
+	k_work_init(&defer->work, work_handler);
+}
+
+void zbus_defer_enqueue(struct zbus_defer *defer,
+			const struct zbus_channel *chan)
+{
+	struct zbus_defer_buf *buf;
+	k_spinlock_key_t key;
+	void *block;
+
+	if (k_mem_slab_alloc(defer->slab, &block, K_NO_WAIT) != 0) {
+		atomic_inc(&defer->dropped);
+		return;
+	}
+	buf = block;
+
+	__ASSERT(zbus_chan_msg_size(chan) == defer->msg_size,
+		 "%s: deferred listener sized for another message type",
+		 zbus_chan_name(chan));
+
+	buf->chan = chan;
+	memcpy(buf->msg, zbus_chan_const_msg(chan), defer->msg_size);
+
+	key = k_spin_lock(&defer->lock);
+	sys_slist_append(&defer->pending, &buf->node);
+	k_spin_unlock(&defer->lock, key);
+
+	k_work_submit_to_queue(defer->workq ? defer->workq : &k_sys_work_q,
+			       &defer->work);
+}
@@ -0,0 +1,95 @@
+/*
+ * Deferred Zbus Listeners
+ *
+ * A zbus listener runs inside zbus_chan_pub() with the channel locked,
+ * so whatever it does (formatting and printing a line, say) is added
+ * to the publisher's latency and keeps other publishers and readers of
+ * the channel waiting. A deferred listener only copies the published
+ * message into a buffer of its own and submits a work item; its
+ * handler runs later on a workqueue of your choice with that snapshot:
+ *
+ *   static void display_handler(const struct zbus_channel *chan,
+ *                               const void *msg)
+ *   {
+ *           const struct sensor_data *data = msg;
+ *           ...
+ *   }
+ *
+ *   ZBUS_DEFERRED_LISTENER_DEFINE(display_lis, display_handler,
+ *                                 struct sensor_data, 4, &display_q);
+ *   ZBUS_CHAN_ADD_OBS(sensor_chan, display_lis, 0);
+ *
+ * The result is an ordinary observer, so it is attached like any other
+ * listener. Snapshots are handled in publish order. When all buffers
+ * are in use the publish is not delayed; that message is dropped and
+ * counted instead.
+ */
+
+#ifndef ZBUS_DEFER_H_
+#define ZBUS_DEFER_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+typedef void (*zbus_defer_handler_t)(const struct zbus_channel *chan,
+				     const void *msg);
+
+struct zbus_defer {
+	zbus_defer_handler_t handler;
+	struct k_work_q *workq;		/* NULL: system workqueue */
+	struct k_mem_slab *slab;
+	size_t msg_size;
+
+	sys_slist_t pending;		/* oldest first */
+	struct k_spinlock lock;
+	struct k_work work;
+
+	/* Statistics */
+	atomic_t handled;
+	atomic_t dropped;		/* no free buffer at publish */
+};
+
+struct zbus_defer_buf {
+	sys_snode_t node;
+	const struct zbus_channel *chan;
+	uint8_t msg[] __aligned(8);
+};
+
+#define ZBUS_DEFER_BLOCK_SIZE(msg_size)                                    \
+	ROUND_UP(sizeof(struct zbus_defer_buf) + (msg_size), 8)
+
+/* Set up the work item; ZBUS_DEFERRED_LISTENER_DEFINE does this at boot */
+void zbus_defer_init(struct zbus_defer *defer);
+void zbus_defer_enqueue(struct zbus_defer *defer,
+			const struct zbus_channel *chan);
+
+/*
+ * Define listener @p _name that runs @p _handler on @p _workq (NULL for
+ * the system workqueue) with a copy of each @p _type message, keeping
+ * up to @p _depth copies not yet handled. Its state is <_name>_defer.
+ */
+#define ZBUS_DEFERRED_LISTENER_DEFINE(_name, _handler, _type, _depth,      \
+				      _workq)                              \
+	K_MEM_SLAB_DEFINE_STATIC(_name##_slab,                             \
+				 ZBUS_DEFER_BLOCK_SIZE(sizeof(_type)),     \
+				 _depth, 8);                               \
+	struct zbus_defer _name##_defer = {                                \
+		.handler = (_handler),                                     \
+		.workq = (_workq),                                         \
+		.slab = &_name##_slab,                                     \
+		.msg_size = sizeof(_type),                                 \
+	};                                                                 \
+	static int _name##_init(void)                                      \
+	{                                                                  \
+		zbus_defer_init(&_name##_defer);                           \
+		return 0;                                                  \
+	}                                                                  \
+	SYS_INIT(_name##_init, APPLICATION,                                \
+		 CONFIG_APPLICATION_INIT_PRIORITY);                        \
+	static void _name##_enqueue(const struct zbus_channel *chan)       \
+	{                                                                  \
+		zbus_defer_enqueue(&_name##_defer, chan);                  \
+	}                                                                  \
+	ZBUS_LISTENER_DEFINE(_name, _name##_enqueue)
+
+#endif /* ZBUS_DEFER_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Reference-Counted Zbus Subscribers
+ *
+ * The listener runs in the publisher's context while the channel is
+ * locked, so the message it copies is exactly the one being published.
+ * It holds one reference of its own while handing out the others, so a
+ * subscriber that is done before the loop ends cannot free the buffer
+ * under it.
+ */
+
+#include <string.h>
+
+#include "zbus_ref.h"
+
+static void ref_listener(const struct zbus_channel *chan)
+{
+	struct zbus_ref_chan *rc = zbus_chan_user_data(chan);
+	struct zbus_ref_sub *sub;
+	struct zbus_ref_buf *buf;
+	void *block;
+
+	if (rc == NULL || sys_slist_is_empty(&rc->subs)) {
+		return;
+	}
+
+	if (k_mem_slab_alloc(rc->slab, &block, K_NO_WAIT) != 0) {
+		atomic_inc(&rc->alloc_fails);
+		return;
+	}
+	buf = block;
+
+	__ASSERT(zbus_chan_msg_size(chan) == rc->msg_size,
+		 "%s: pool sized for another message type",
+		 zbus_chan_name(chan));
+
+	atomic_set(&buf->refs, 1);
+	buf->owner = rc;
+	buf->chan = chan;
+	memcpy(buf->msg, zbus_chan_const_msg(chan), rc->msg_size);
+	atomic_inc(&rc->copies);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&rc->subs, sub, node) {
+		atomic_inc(&buf->refs);
+		if (k_msgq_put(sub->queue, &buf, K_NO_WAIT) != 0) {
+			atomic_dec(&buf->refs);
+			atomic_inc(&sub->dropped);
+		}
+	}
+
+	zbus_ref_unref(buf);
+}
+
+ZBUS_LISTENER_DEFINE(zbus_ref_lis, ref_listener);
+
+void zbus_ref_attach(struct zbus_ref_chan *rc, struct zbus_ref_sub *sub)
+{
+	sys_slist_append(&rc->subs, &sub->node);
+}
+
+int zbus_ref_sub_wait(struct zbus_ref_sub *sub, struct zbus_ref_buf **buf,
+		      k_timeout_t timeout)
+{
+	return k_msgq_get(sub->queue, buf, timeout) == 0 ? 0 : -EAGAIN;
+}
+
+void zbus_ref_unref(struct zbus_ref_buf *buf)
+{
+	if (atomic_dec(&buf->refs) == 1) {
+		k_mem_slab_free(buf->owner->slab, buf);
+	}
+}
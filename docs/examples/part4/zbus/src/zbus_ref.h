@@ -0,0 +1,103 @@
+/*
+ * Reference-Counted Zbus Subscribers
+ *
+ * A plain zbus subscriber is only told which channel changed and has to
+ * zbus_chan_read() the message afterwards, by which time a newer publish
+ * may have replaced it. A ref subscriber instead receives the exact
+ * message that was published, in a reference-counted buffer:
+ *
+ *   - zbus_ref_lis, attached to the channel as a listener, copies each
+ *     published message once into a buffer from the channel's pool and
+ *     queues a reference to it for every ref subscriber
+ *   - each subscriber reads the message in place and drops its
+ *     reference with zbus_ref_unref(); the last one frees the buffer
+ *
+ * However many ref subscribers there are, each publish costs one copy.
+ * Setup: give the channel a zbus_ref_chan as user data and attach
+ * zbus_ref_lis to it:
+ *
+ *   ZBUS_REF_CHAN_DEFINE(sensor_ref, struct sensor_data, 8);
+ *   ZBUS_CHAN_DEFINE(sensor_chan, struct sensor_data, NULL, &sensor_ref,
+ *                    ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+ *   ZBUS_CHAN_ADD_OBS(sensor_chan, zbus_ref_lis, 2);
+ *
+ *   ZBUS_REF_SUB_DEFINE(logger_ref, 8);
+ *   zbus_ref_attach(&sensor_ref, &logger_ref);   (before publishing)
+ */
+
+#ifndef ZBUS_REF_H_
+#define ZBUS_REF_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+struct zbus_ref_chan {
+	struct k_mem_slab *slab;
+	size_t msg_size;
+	sys_slist_t subs;
+
+	/* Statistics */
+	atomic_t copies;
+	atomic_t alloc_fails;	/* pool empty: no subscriber got it */
+};
+
+struct zbus_ref_sub {
+	const char *name;
+	struct k_msgq *queue;	/* of struct zbus_ref_buf * */
+	sys_snode_t node;
+	atomic_t dropped;	/* queue full */
+};
+
+struct zbus_ref_buf {
+	atomic_t refs;
+	struct zbus_ref_chan *owner;
+	const struct zbus_channel *chan;
+	uint8_t msg[] __aligned(8);
+};
+
+#define ZBUS_REF_BLOCK_SIZE(msg_size)                                      \
+	ROUND_UP(sizeof(struct zbus_ref_buf) + (msg_size), 8)
+
+/* Pool of @p _count buffers for messages of type @p _type */
+#define ZBUS_REF_CHAN_DEFINE(_name, _type, _count)                         \
+	K_MEM_SLAB_DEFINE_STATIC(_name##_slab,                             \
+				 ZBUS_REF_BLOCK_SIZE(sizeof(_type)),       \
+				 _count, 8);                               \
+	struct zbus_ref_chan _name = {                                     \
+		.slab = &_name##_slab,                                     \
+		.msg_size = sizeof(_type),                                 \
+	}
+
+/* Subscriber holding up to @p _depth unread messages */
+#define ZBUS_REF_SUB_DEFINE(_name, _depth)                                 \
+	K_MSGQ_DEFINE(_name##_queue, sizeof(struct zbus_ref_buf *),        \
+		      _depth, sizeof(void *));                             \
+	struct zbus_ref_sub _name = {                                      \
+		.name = #_name,                                            \
+		.queue = &_name##_queue,                                   \
+	}
+
+/* Listener that hands each publish to the channel's ref subscribers */
+ZBUS_OBS_DECLARE(zbus_ref_lis);
+
+/* Subscribe @p sub to @p rc; call before the channel is first published */
+void zbus_ref_attach(struct zbus_ref_chan *rc, struct zbus_ref_sub *sub);
+
+/**
+ * Wait for the next message. The caller owns one reference to @p buf
+ * and must drop it with zbus_ref_unref() when done.
+ *
+ * @retval 0 Message received.
+ * @retval -EAGAIN Nothing arrived within @p timeout.
+ */
+int zbus_ref_sub_wait(struct zbus_ref_sub *sub, struct zbus_ref_buf **buf,
+		      k_timeout_t timeout);
+
+static inline const void *zbus_ref_msg(const struct zbus_ref_buf *buf)
+{
+	return buf->msg;
+}
+
+void zbus_ref_unref(struct zbus_ref_buf *buf);
+
+#endif /* ZBUS_REF_H_ */
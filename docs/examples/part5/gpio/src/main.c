@@ -7,6 +7,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/gpio.h>
 
+#include "prio_wq.h"
+
+#define PRIO_WQ_PRIORITY 2
+
 /* Get LED and button from devicetree */
 #define LED0_NODE DT_ALIAS(led0)
 #define SW0_NODE  DT_ALIAS(sw0)
@@ -23,7 +27,10 @@ static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 static const struct gpio_dt_spec button = GPIO_DT_SPEC_GET(SW0_NODE, gpios);
 
 static struct gpio_callback button_cb_data;
-static struct k_work button_work;
+static struct prio_work button_work;
+
+/* Button feedback should follow a press within 20 ms */
+static PRIO_WORK_TYPE_DEFINE(button_type, "button");
 
 /* Work handler for button processing */
 void button_work_handler(struct k_work *work)
@@ -42,7 +49,7 @@ void button_pressed(const struct device *dev, struct gpio_callback *cb,
 		    uint32_t pins)
 {
 	/* Submit work to handle button press (don't do heavy work in ISR) */
-	k_work_submit(&button_work);
+	prio_work_submit(&button_work, K_MSEC(20));
 }
 
 int main(void)
@@ -82,8 +89,10 @@ int main(void)
 		return -1;
 	}
 
-	/* Initialize work item */
-	k_work_init(&button_work, button_work_handler);
+	/* Initialize work item in the high class, ahead of any slow work */
+	prio_wq_start(PRIO_WQ_PRIORITY);
+	prio_work_init(&button_work, button_work_handler, &button_type,
+		       PRIO_WQ_HIGH);
 
 	/* Set up button callback */
 	gpio_init_callback(&button_cb_data, button_pressed, BIT(button.pin));
@@ -100,6 +109,7 @@ int main(void)
 	while (1) {
 		k_sleep(K_SECONDS(5));
 		printk("Still running... (press button to interact)\n");
+		prio_wq_dump();
 	}
 
 	return 0;
@@ -0,0 +1,16 @@
+/*
+ * Native Simulator Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so compare the blocking counts there and use qemu or
+ * a real board for absolute throughput.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* k_mutex vs reader-writer lock at 90/10 and 99/1 read/write mixes */
+void bench_rwlock(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,148 @@
+/*
+ * Reader-Writer Lock Benchmark
+ *
+ * Four threads share a small state struct, like event_count in this
+ * example, and mostly read it. Each op is a read or, for 10% or 1% of
+ * ops, an update. The struct is guarded either by a k_mutex or by the
+ * reader-writer lock. Every eighth op yields while holding the lock,
+ * as if the holder were preempted, so that other threads actually
+ * arrive at a held lock. The "blocked" column counts acquisitions that
+ * found the lock unavailable and had to sleep.
+ */
+
+#include <zephyr/kernel.h>
+
+#include "rwlock.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_THREADS 4
+#define OPS_PER_THREAD 5000
+#define YIELD_EVERY 8
+#define BENCH_PRIO 7
+
+static const uint32_t write_pcts[] = { 10, 1 };
+
+struct shared_state {
+	uint32_t event_count;
+	int32_t last_reading;
+	uint32_t timestamp;
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(rw_stacks, BENCH_THREADS, STACK_SIZE);
+static struct k_thread rw_threads[BENCH_THREADS];
+
+static struct shared_state state;
+static K_MUTEX_DEFINE(state_bench_mutex);
+static struct rwlock state_rwlock;	/* initialized per run */
+
+static bool use_rwlock;
+static uint32_t write_pct;
+static atomic_t mutex_blocked;
+static atomic_t checksum;	/* keeps reads from being optimized out */
+
+static void lock_for(bool write)
+{
+	if (use_rwlock) {
+		if (write) {
+			rwlock_write_lock(&state_rwlock, K_FOREVER);
+		} else {
+			rwlock_read_lock(&state_rwlock, K_FOREVER);
+		}
+		return;
+	}
+
+	if (k_mutex_lock(&state_bench_mutex, K_NO_WAIT) != 0) {
+		atomic_inc(&mutex_blocked);
+		k_mutex_lock(&state_bench_mutex, K_FOREVER);
+	}
+}
+
+static void unlock_for(bool write)
+{
+	if (!use_rwlock) {
+		k_mutex_unlock(&state_bench_mutex);
+	} else if (write) {
+		rwlock_write_unlock(&state_rwlock);
+	} else {
+		rwlock_read_unlock(&state_rwlock);
+	}
+}
+
+static void rw_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t id = POINTER_TO_UINT(p1);
+	uint32_t sum = 0;
+
+	for (uint32_t i = 0; i < OPS_PER_THREAD; i++) {
+		/* Stagger threads so they do not all write on the same op */
+		bool write = ((i + id * 37) % 100) < write_pct;
+
+		lock_for(write);
+		if (write) {
+			state.event_count++;
+			state.last_reading = 2200 + (int32_t)(i % 400);
+			state.timestamp = i;
+		} else {
+			struct shared_state snap = state;
+
+			sum += snap.event_count + snap.timestamp;
+		}
+		if ((i % YIELD_EVERY) == 0) {
+			k_yield();
+		}
+		unlock_for(write);
+	}
+
+	atomic_add(&checksum, sum);
+}
+
+static void run(bool rw, uint32_t pct)
+{
+	use_rwlock = rw;
+	write_pct = pct;
+	state = (struct shared_state){ 0 };
+	atomic_clear(&mutex_blocked);
+	rwlock_init(&state_rwlock);
+
+	for (uint32_t i = 0; i < BENCH_THREADS; i++) {
+		k_thread_create(&rw_threads[i], rw_stacks[i], STACK_SIZE,
+				rw_entry, UINT_TO_POINTER(i), NULL, NULL,
+				BENCH_PRIO, 0, K_FOREVER);
+	}
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < BENCH_THREADS; i++) {
+		k_thread_start(&rw_threads[i]);
+	}
+	for (uint32_t i = 0; i < BENCH_THREADS; i++) {
+		k_thread_join(&rw_threads[i], K_FOREVER);
+	}
+
+	uint32_t elapsed = k_cycle_get_32() - start;
+	uint64_t ops = (uint64_t)BENCH_THREADS * OPS_PER_THREAD;
+	uint64_t per_sec = elapsed ? ops * sys_clock_hw_cycles_per_sec() /
+		elapsed : 0;
+	uint32_t blocked = rw ? atomic_get(&state_rwlock.read_waits) +
+				atomic_get(&state_rwlock.write_waits) :
+			   atomic_get(&mutex_blocked);
+
+	printk("%-8s %2u/%-2u %12llu %8u %8u\n", rw ? "rwlock" : "k_mutex",
+	       100 - pct, pct, (unsigned long long)per_sec, blocked,
+	       state.event_count);
+}
+
+void bench_rwlock(void)
+{
+	printk("\n--- Benchmark: read-mostly shared state ---\n");
+	printk("%d threads x %d ops, holder yields every %d ops\n",
+	       BENCH_THREADS, OPS_PER_THREAD, YIELD_EVERY);
+	printk("%-8s %5s %12s %8s %8s\n", "lock", "r/w", "ops/s", "blocked",
+	       "writes");
+
+	for (size_t i = 0; i < ARRAY_SIZE(write_pcts); i++) {
+		run(false, write_pcts[i]);
+		run(true, write_pcts[i]);
+	}
+}
@@ -11,6 +11,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include "lock_prof.h"
+#include "periodic_sched.h"
+#include "bench.h"
+
 LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
 
 #define STACK_SIZE 1024
@@ -21,6 +25,7 @@ static struct k_thread worker_data;
 
 /* Shared state */
 static K_MUTEX_DEFINE(state_mutex);
+LOCK_PROF_DEFINE(state_mutex);
 static int event_count;
 
 /* Simulated sensor that works on native_sim */
@@ -44,9 +49,9 @@ static void worker_entry(void *p1, void *p2, void *p3)
 	for (int i = 0; i < MAX_CYCLES; i++) {
 		int reading = simulate_sensor_read();
 
-		k_mutex_lock(&state_mutex, K_FOREVER);
+		lock_prof_lock(&state_mutex_prof, K_FOREVER);
 		event_count++;
-		k_mutex_unlock(&state_mutex);
+		lock_prof_unlock(&state_mutex_prof);
 
 		LOG_INF("Sensor reading %d: %d.%02d C",
 			i + 1, reading / 100, reading % 100);
@@ -62,6 +67,35 @@ static void worker_entry(void *p1, void *p2, void *p3)
 	LOG_INF("Worker thread completed %d readings", MAX_CYCLES);
 }
 
+/* Housekeeping tasks that need not run at an exact time */
+static void heartbeat_task(struct periodic_task *task)
+{
+	LOG_INF("Heartbeat (%u)", task->runs + 1);
+}
+
+static void sensor_task(struct periodic_task *task)
+{
+	int reading = simulate_sensor_read();
+
+	LOG_DBG("Background reading: %d.%02d C", reading / 100,
+		reading % 100);
+}
+
+static void battery_task(struct periodic_task *task)
+{
+	LOG_DBG("Battery check");
+}
+
+static void stats_task(struct periodic_task *task)
+{
+	LOG_DBG("Stats flush");
+}
+
+PERIODIC_TASK_DEFINE(heartbeat, heartbeat_task, 1000, 200);
+PERIODIC_TASK_DEFINE(sensor_poll, sensor_task, 500, 100);
+PERIODIC_TASK_DEFINE(battery_check, battery_task, 2000, 500);
+PERIODIC_TASK_DEFINE(stats_flush, stats_task, 700, 300);
+
 int main(void)
 {
 	printk("\n");
@@ -78,12 +112,31 @@ int main(void)
 				      5, 0, K_NO_WAIT);
 	k_thread_name_set(tid, "worker");
 
+	/* Dump mutex contention every 2 s; "lockprof" in the shell too */
+	lock_prof_dump_start(K_SECONDS(2));
+
 	/* Wait for worker to finish */
 	k_thread_join(&worker_data, K_FOREVER);
+	lock_prof_dump_stop();
 
-	k_mutex_lock(&state_mutex, K_FOREVER);
+	lock_prof_lock(&state_mutex_prof, K_FOREVER);
 	LOG_INF("Total events processed: %d", event_count);
-	k_mutex_unlock(&state_mutex);
+	lock_prof_unlock(&state_mutex_prof);
+
+	lock_prof_dump();
+
+	bench_rwlock();
+
+	/* Periodic tasks sharing wakeups; ticks are 10 ms (see prj.conf) */
+	printk("\nBatched periodic tasks for 10 s\n");
+	periodic_sched_add(&heartbeat);
+	periodic_sched_add(&sensor_poll);
+	periodic_sched_add(&battery_check);
+	periodic_sched_add(&stats_flush);
+	periodic_sched_start();
+	k_sleep(K_SECONDS(10));
+	periodic_sched_stop();
+	periodic_sched_dump();
 
 	LOG_INF("Application complete - exiting");
 
@@ -9,11 +9,28 @@
 #include <zephyr/shell/shell.h>
 #include <stdlib.h>
 
+#include "rwlock.h"
+
 /* Application state accessible from shell */
 static int led_state;
+
+/*
+ * Sensor state: read by every shell command and each sensor cycle,
+ * written rarely, so readers share the lock and only writers exclude.
+ */
+static struct rwlock sensor_lock;
 static int sensor_interval_ms = 1000;
 static int sensor_reading;
 
+/* Runs before the sensor thread and the shell start */
+static int sensor_lock_init(void)
+{
+	rwlock_init(&sensor_lock);
+	return 0;
+}
+
+SYS_INIT(sensor_lock_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
 /* ---- LED commands ---- */
 
 static int cmd_led_on(const struct shell *sh, size_t argc, char **argv)
@@ -63,15 +80,22 @@ static int cmd_sensor_read(const struct shell *sh, size_t argc, char **argv)
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
 
-	shell_print(sh, "Temperature: %d.%02d C",
-		    sensor_reading / 100, sensor_reading % 100);
+	rwlock_read_lock(&sensor_lock, K_FOREVER);
+	int reading = sensor_reading;
+	rwlock_read_unlock(&sensor_lock);
+
+	shell_print(sh, "Temperature: %d.%02d C", reading / 100, reading % 100);
 	return 0;
 }
 
 static int cmd_sensor_interval(const struct shell *sh, size_t argc, char **argv)
 {
 	if (argc < 2) {
-		shell_print(sh, "Current interval: %d ms", sensor_interval_ms);
+		rwlock_read_lock(&sensor_lock, K_FOREVER);
+		int interval = sensor_interval_ms;
+		rwlock_read_unlock(&sensor_lock);
+
+		shell_print(sh, "Current interval: %d ms", interval);
 		return 0;
 	}
 
@@ -81,8 +105,11 @@ static int cmd_sensor_interval(const struct shell *sh, size_t argc, char **argv)
 		return -EINVAL;
 	}
 
+	rwlock_write_lock(&sensor_lock, K_FOREVER);
 	sensor_interval_ms = val;
-	shell_print(sh, "Sensor interval set to %d ms", sensor_interval_ms);
+	rwlock_write_unlock(&sensor_lock);
+
+	shell_print(sh, "Sensor interval set to %d ms", val);
 	return 0;
 }
 
@@ -119,13 +146,18 @@ static void sensor_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	sensor_reading = 2500;
+	int reading = 2500;
 
 	while (1) {
 		/* Simulate sensor drift */
-		sensor_reading += (k_cycle_get_32() % 11) - 5;
+		reading += (int)(k_cycle_get_32() % 11) - 5;
+
+		rwlock_write_lock(&sensor_lock, K_FOREVER);
+		sensor_reading = reading;
+		int interval = sensor_interval_ms;
+		rwlock_write_unlock(&sensor_lock);
 
-		k_msleep(sensor_interval_ms);
+		k_msleep(interval);
 	}
 }
 
@@ -0,0 +1,16 @@
+/*
+ * Tracing Example Benchmarks
+ *
+ * Each benchmark prints its own results with printk. Timings are in
+ * hardware cycles (k_cycle_get_32). On native_sim, code runs in zero
+ * simulated time, so compare retry and consistency counts there and
+ * use qemu or a real board for absolute latency and throughput.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/* data_mutex vs seqlock cell: reader latency and writer throughput */
+void bench_seqlock(void);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,151 @@
+/*
+ * Seqlock Cell Benchmark
+ *
+ * One writer publishes struct sensor_data samples while two readers
+ * copy the latest one, first with the struct guarded by data_mutex and
+ * then through a seqlock cell. All threads share one priority and yield
+ * every few operations, so readers and the writer interleave. Each
+ * sample satisfies humidity == 2 * temperature, which lets readers
+ * count torn copies (there should be none).
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "lat_hist.h"
+#include "lock_prof.h"
+#include "sensor_data.h"
+#include "seqlock_cell.h"
+#include "bench.h"
+
+#define STACK_SIZE 1024
+#define BENCH_READERS 2
+#define BENCH_WRITES 2000
+#define BENCH_READS 5000
+#define YIELD_EVERY 4
+#define BENCH_PRIO 7
+
+K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(reader_stacks, BENCH_READERS, STACK_SIZE);
+static struct k_thread writer_thread;
+static struct k_thread reader_threads[BENCH_READERS];
+
+/* Mutex version, as the example used to share its data */
+static K_MUTEX_DEFINE(data_mutex);
+LOCK_PROF_DEFINE(data_mutex);
+static struct sensor_data mutex_sample;
+
+SEQLOCK_CELL_DEFINE(bench_cell, struct sensor_data);
+
+static bool use_seqlock;
+static uint32_t writer_cycles;
+static struct k_spinlock hist_lock;
+static struct lat_hist hist;
+static atomic_t torn;
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 1; i <= BENCH_WRITES; i++) {
+		struct sensor_data sample = {
+			.temperature = i,
+			.humidity = 2 * i,
+			.timestamp = i,
+		};
+
+		if (use_seqlock) {
+			seqlock_cell_publish(&bench_cell, &sample);
+		} else {
+			lock_prof_lock(&data_mutex_prof, K_FOREVER);
+			mutex_sample = sample;
+			lock_prof_unlock(&data_mutex_prof);
+		}
+
+		if ((i % YIELD_EVERY) == 0) {
+			k_yield();
+		}
+	}
+
+	writer_cycles = k_cycle_get_32() - start;
+}
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	struct sensor_data sample;
+
+	for (int i = 1; i <= BENCH_READS; i++) {
+		uint32_t start = k_cycle_get_32();
+
+		if (use_seqlock) {
+			seqlock_cell_read(&bench_cell, &sample);
+		} else {
+			lock_prof_lock(&data_mutex_prof, K_FOREVER);
+			sample = mutex_sample;
+			lock_prof_unlock(&data_mutex_prof);
+		}
+
+		uint32_t cycles = k_cycle_get_32() - start;
+		k_spinlock_key_t key = k_spin_lock(&hist_lock);
+
+		lat_hist_add(&hist, cycles);
+		k_spin_unlock(&hist_lock, key);
+
+		if (sample.humidity != 2 * sample.temperature) {
+			atomic_inc(&torn);
+		}
+
+		if ((i % YIELD_EVERY) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static void run(bool seqlock)
+{
+	use_seqlock = seqlock;
+	memset(&hist, 0, sizeof(hist));
+	atomic_clear(&torn);
+	atomic_clear(&bench_cell.retries);
+
+	k_thread_create(&writer_thread, writer_stack, STACK_SIZE,
+			writer_entry, NULL, NULL, NULL, BENCH_PRIO, 0,
+			K_FOREVER);
+	for (int i = 0; i < BENCH_READERS; i++) {
+		k_thread_create(&reader_threads[i], reader_stacks[i],
+				STACK_SIZE, reader_entry, NULL, NULL, NULL,
+				BENCH_PRIO, 0, K_FOREVER);
+	}
+
+	k_thread_start(&writer_thread);
+	for (int i = 0; i < BENCH_READERS; i++) {
+		k_thread_start(&reader_threads[i]);
+	}
+
+	k_thread_join(&writer_thread, K_FOREVER);
+	for (int i = 0; i < BENCH_READERS; i++) {
+		k_thread_join(&reader_threads[i], K_FOREVER);
+	}
+
+	uint64_t writes_per_sec = writer_cycles ? (uint64_t)BENCH_WRITES *
+		sys_clock_hw_cycles_per_sec() / writer_cycles : 0;
+
+	printk("%-8s %10llu %8u %8u %8u %7u %5u\n",
+	       seqlock ? "seqlock" : "mutex",
+	       (unsigned long long)writes_per_sec, lat_hist_percentile(&hist, 500),
+	       lat_hist_percentile(&hist, 990), hist.max,
+	       seqlock ? (uint32_t)atomic_get(&bench_cell.retries) : 0,
+	       (uint32_t)atomic_get(&torn));
+}
+
+void bench_seqlock(void)
+{
+	printk("\n--- Benchmark: latest-value sharing ---\n");
+	printk("%d writes, %d readers x %d reads\n", BENCH_WRITES,
+	       BENCH_READERS, BENCH_READS);
+	printk("%-8s %10s %8s %8s %8s %7s %5s\n", "sharing", "writes/s",
+	       "rd p50", "rd p99", "rd max", "retries", "torn");
+
+	run(false);
+	run(true);
+}
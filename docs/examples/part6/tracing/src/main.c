@@ -11,6 +11,12 @@
 
 #include <zephyr/kernel.h>
 
+#include "lock_prof.h"
+#include "thread_mon.h"
+#include "sensor_data.h"
+#include "seqlock_cell.h"
+#include "bench.h"
+
 #define STACK_SIZE 1024
 
 K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
@@ -21,10 +27,9 @@ static struct k_thread consumer_data;
 
 /* Synchronization objects (traced by CTF) */
 static K_SEM_DEFINE(data_ready, 0, 1);
-static K_MUTEX_DEFINE(data_mutex);
 
-/* Shared data */
-static int shared_value;
+/* Latest sample; readers never block the producer */
+SEQLOCK_CELL_DEFINE(latest_sample, struct sensor_data);
 
 /* Producer: generates data and signals consumer */
 static void producer_entry(void *p1, void *p2, void *p3)
@@ -37,15 +42,20 @@ static void producer_entry(void *p1, void *p2, void *p3)
 		/* Simulate work (this shows up in trace timeline) */
 		k_busy_wait(1000);
 
-		/* Update shared data under mutex */
-		k_mutex_lock(&data_mutex, K_FOREVER);
-		shared_value = i * 10;
-		k_mutex_unlock(&data_mutex);
+		/* Publish the new sample */
+		struct sensor_data sample = {
+			.temperature = 20000 + i * 10,
+			.humidity = 45000 + i * 100,
+			.timestamp = k_uptime_get_32(),
+		};
+
+		seqlock_cell_publish(&latest_sample, &sample);
 
 		/* Signal consumer */
 		k_sem_give(&data_ready);
 
-		printk("[Producer] Produced value: %d\n", i * 10);
+		printk("[Producer] Produced: temp=%d mC, hum=%d m%%\n",
+		       sample.temperature, sample.humidity);
 
 		/* Variable delay to create interesting trace patterns */
 		k_msleep(100 + (i % 3) * 50);
@@ -65,15 +75,15 @@ static void consumer_entry(void *p1, void *p2, void *p3)
 		/* Wait for producer signal (traced as semaphore take) */
 		k_sem_take(&data_ready, K_FOREVER);
 
-		/* Read shared data under mutex */
-		k_mutex_lock(&data_mutex, K_FOREVER);
-		int val = shared_value;
-		k_mutex_unlock(&data_mutex);
+		/* Copy a consistent snapshot of the latest sample */
+		struct sensor_data sample;
+		uint32_t seq = seqlock_cell_read(&latest_sample, &sample);
 
 		/* Simulate processing */
 		k_busy_wait(500);
 
-		printk("[Consumer] Consumed value: %d\n", val);
+		printk("[Consumer] Consumed: temp=%d mC (sample %u @ %u ms)\n",
+		       sample.temperature, seq, sample.timestamp);
 	}
 
 	printk("[Consumer] Done\n");
@@ -102,10 +112,20 @@ int main(void)
 			       6, 0, K_NO_WAIT);
 	k_thread_name_set(tid2, "consumer");
 
+	/* Sample per-thread CPU share and stack use every second */
+	thread_mon_start(K_SECONDS(1));
+
 	/* Wait for both to finish */
 	k_thread_join(&producer_data, K_FOREVER);
 	k_thread_join(&consumer_data, K_FOREVER);
 
+	thread_mon_stop();
+	thread_mon_print();
+
+	/* Mutex vs seqlock; the mutex side is lock-profiled */
+	bench_seqlock();
+	lock_prof_dump();
+
 	printk("\nTracing example complete.\n");
 	printk("Analyze CTF output with: babeltrace <trace-dir>\n");
 
@@ -0,0 +1,16 @@
+/*
+ * Sensor sample shared by the tracing example and its benchmark
+ */
+
+#ifndef SENSOR_DATA_H_
+#define SENSOR_DATA_H_
+
+#include <stdint.h>
+
+struct sensor_data {
+	int32_t temperature;  /* milli-Celsius */
+	int32_t humidity;     /* milli-percent */
+	uint32_t timestamp;
+};
+
+#endif /* SENSOR_DATA_H_ */
@@ -0,0 +1,48 @@
+/*
+ * Seqlock "Latest Value" Cell
+ *
+ * The writer holds a spinlock, so on a single CPU it cannot be
+ * preempted mid-write. A reader can therefore only see an odd sequence
+ * on SMP, where the writer is running on another CPU and will finish
+ * soon. That bounds the retry loop. Full fences keep the data copy
+ * between the two sequence accesses on both sides.
+ */
+
+#include <string.h>
+#include <zephyr/sys/barrier.h>
+
+#include "seqlock_cell.h"
+
+void seqlock_cell_publish(struct seqlock_cell *cell, const void *value)
+{
+	k_spinlock_key_t key = k_spin_lock(&cell->write_lock);
+
+	atomic_inc(&cell->seq);
+	barrier_dmem_fence_full();
+	memcpy(cell->data, value, cell->size);
+	barrier_dmem_fence_full();
+	atomic_inc(&cell->seq);
+
+	k_spin_unlock(&cell->write_lock, key);
+}
+
+uint32_t seqlock_cell_read(struct seqlock_cell *cell, void *out)
+{
+	uint32_t start;
+
+	while (true) {
+		start = atomic_get(&cell->seq);
+		if ((start & 1) == 0) {
+			barrier_dmem_fence_full();
+			memcpy(out, cell->data, cell->size);
+			barrier_dmem_fence_full();
+			if ((uint32_t)atomic_get(&cell->seq) == start) {
+				break;
+			}
+		}
+		atomic_inc(&cell->retries);
+	}
+
+	/* Two increments per publish */
+	return start / 2;
+}
@@ -0,0 +1,49 @@
+/*
+ * Seqlock "Latest Value" Cell
+ *
+ * Holds the most recent value of a small plain-data struct. A writer
+ * publishes a new value without waiting for readers, and readers copy
+ * the value out without taking any lock. A sequence counter that is odd
+ * while a write is in progress tells a reader that its copy may be torn,
+ * and the reader simply copies again.
+ *
+ * Readers never block writers and never see a half-updated struct, but
+ * may retry while a write is in flight. Only the latest value is kept;
+ * use a queue when every value matters.
+ */
+
+#ifndef SEQLOCK_CELL_H_
+#define SEQLOCK_CELL_H_
+
+#include <zephyr/kernel.h>
+
+struct seqlock_cell {
+	atomic_t seq;			/* odd while a write is in progress */
+	struct k_spinlock write_lock;	/* serializes writers */
+	void *data;
+	size_t size;
+
+	atomic_t retries;		/* reads that had to copy again */
+};
+
+/* Define cell @p name holding a value of @p type, initially zeroed */
+#define SEQLOCK_CELL_DEFINE(name, type)                                    \
+	static type _seqlock_data_##name;                                  \
+	static struct seqlock_cell name = {                                \
+		.data = &_seqlock_data_##name,                             \
+		.size = sizeof(type),                                      \
+	}
+
+/* Replace the value with the @p size bytes at @p value */
+void seqlock_cell_publish(struct seqlock_cell *cell, const void *value);
+
+/**
+ * Copy the latest value to @p out.
+ *
+ * @return Sequence number of the copied value. It grows with every
+ *         publish, so a reader can tell whether the value changed since
+ *         its last read.
+ */
+uint32_t seqlock_cell_read(struct seqlock_cell *cell, void *out);
+
+#endif /* SEQLOCK_CELL_H_ */